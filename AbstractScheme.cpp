@@ -1,85 +1,294 @@
+#include <algorithm>
+#include <cmath>
+#include <exception>
+#include <future>
 #include <iterator>
+#include <limits>
 #include <string>
 #include <fstream>
 #include <iomanip>
+#include <sstream>
 #include "AbstractScheme.h"
 #include "VectorNorms.h"
+#include "FunctionAdapter.h"
+#include "PeriodicFunction.h"
+#include "ThreadPool.h"
 #include "UninitializedFunctionException.h"
+#include "UnstableSchemeException.h"
+#include "StabilityAnalysis.h"
+#include "TimeStepper.h"
 
-AbstractScheme::AbstractScheme(std::ostream& _stream, std::string _name, double _xStart, double _xEnd, double _t, int _spacePoints, double _u, double _cfl)
-	: stream(_stream), name(_name), xStart(_xStart), xEnd(_xEnd), t(_t), spacePoints(_spacePoints), u(_u), cfl(_cfl)
+// The evaluated runs check their values every few time steps, they are cancelled when the values grow by the factor
+static const int divergenceCheckInterval = 16;
+static const double divergenceFactor = 1e3;
+
+template <typename T>
+AbstractScheme<T>::AbstractScheme(std::string _name, double _xStart, double _xEnd, double _t, int _spacePoints, double _u, double _cfl)
+	: name(_name), xStart(_xStart), xEnd(_xEnd), t(_t), spacePoints(_spacePoints), trackActiveRegion(false), u(_u), cfl(_cfl)
 {
-	calculateDeltas();
+
 }
 
-AbstractScheme::~AbstractScheme()
+template <typename T>
+AbstractScheme<T>::~AbstractScheme()
 {
 
 }
 
-void AbstractScheme::calculateDeltas()
+template <typename T>
+std::unique_ptr<SimulationState<T>> AbstractScheme<T>::createState() const
 {
-	deltaX = (fabs(xStart) + fabs(xEnd)) / (spacePoints);
-	deltaT = (cfl * deltaX) / u;
+	return createState(spacePoints, t, cfl);
 }
 
-void AbstractScheme::boundaryCondition(std::function< double(double) > boundaryFunction)
+template <typename T>
+std::unique_ptr<SimulationState<T>> AbstractScheme<T>::createState(int _spacePoints, double _t, double _cfl) const
 {
-	currentValues.clear();
+	auto state = allocateState();
 
-	currentValues.push_back(left);
+	state->grid = Grid::get(xStart, xEnd, _spacePoints);
+	state->spacePoints = _spacePoints;
+	state->t = _t;
+	state->cfl = _cfl;
+	state->deltaX = state->grid->getDelta();
+	state->deltaT = stepLength(_cfl, state->deltaX, _t);
 
-	for (auto i = xStart + deltaX; i < xEnd; i += deltaX) {
-		currentValues.push_back(boundaryFunction(i));
-	}
+	// The tolerance keeps the last step when t is a multiple of deltaT
+	state->timeSteps = (int)std::floor(_t / state->deltaT + 1e-9);
+
+	return state;
+}
+
+template <typename T>
+std::unique_ptr<SimulationState<T>> AbstractScheme<T>::allocateState() const
+{
+	return std::unique_ptr<SimulationState<T>>(new SimulationState<T>());
+}
+
+template <typename T>
+void AbstractScheme<T>::boundaryCondition(SimulationState<T>& state, const BatchFunction& boundaryFunction) const
+{
+	state.currentValues = discretise(*state.grid, boundaryFunction);
+	state.nextValues = state.currentValues;
+}
 
-	currentValues.push_back(right);
+template <typename T>
+std::vector<T> AbstractScheme<T>::discretise(std::function< double(double) > function) const
+{
+	return discretise(FunctionAdapter(function));
+}
+
+template <typename T>
+std::vector<T> AbstractScheme<T>::discretise(const BatchFunction& function) const
+{
+	return discretise(*getGrid(), function);
 }
 
-std::vector<double> AbstractScheme::calculateAnalytical(double t)
+template <typename T>
+std::vector<T> AbstractScheme<T>::discretise(const Grid& grid, const BatchFunction& function) const
 {
-	std::vector<double> analyticalValues;
+	// The whole grid is evaluated with one call, the boundary values are overwritten afterwards
+	std::vector<double> exact(grid.size());
+
+	function.evaluate(grid.coordinates(), 0.0, exact.data(), exact.size());
+
+	std::vector<T> values(exact.begin(), exact.end());
 
-	for (auto i = xStart; i <= xEnd; i += deltaX) {
-		analyticalValues.push_back(analyticalFunction(i, t));
+	// The last point of a periodic domain is the image of the first one
+	if (isPeriodic()) {
+		values[grid.getIntervals()] = values[0];
+		return values;
 	}
 
+	values[0] = left;
+	values[grid.getIntervals()] = right;
+
+	return values;
+}
+
+template <typename T>
+typename AbstractScheme<T>::ArenaVector AbstractScheme<T>::calculateAnalytical(SimulationState<T>& state, double t, int first, int last) const
+{
+	ArenaVector analyticalValues(last - first + 1, 0.0, ArenaAllocator<double>(&state.arena));
+
+	exactFunction(analyticalFunction)->evaluate(state.grid->coordinates() + first, t, analyticalValues.data(), analyticalValues.size());
+
 	return analyticalValues;
 }
 
-void AbstractScheme::evaluate(std::function< double(double) > boundaryFunction, std::ostream *_stream)
+template <typename T>
+int AbstractScheme<T>::stencilRadius() const
+{
+	return 1;
+}
+
+template <typename T>
+double AbstractScheme<T>::stepLength(double _cfl, double deltaX, double _t) const
+{
+	return (_cfl * deltaX) / u;
+}
+
+template <typename T>
+void AbstractScheme<T>::prepare(SimulationState<T>& state, std::shared_ptr<const BatchFunction> initialFunction) const
+{
+
+}
+
+template <typename T>
+void AbstractScheme<T>::report(const SimulationState<T>& state, std::ostream& stream) const
+{
+
+}
+
+template <typename T>
+void AbstractScheme<T>::initialiseActiveRegion(SimulationState<T>& state) const
+{
+	auto& currentValues = state.currentValues;
+	int size = currentValues.size();
+
+	state.activeFirst = 0;
+	state.activeLast = size - 1;
+
+	// The waves of the periodic domains wrap around, the region would not be an interval
+	if (!trackActiveRegion || isPeriodic()) {
+		return;
+	}
+
+	// Find the first and last pair of neighbouring cells with different values
+	while (state.activeFirst < size - 1 && currentValues[state.activeFirst] == currentValues[state.activeFirst + 1]) {
+		state.activeFirst++;
+	}
+
+	while (state.activeLast > state.activeFirst && currentValues[state.activeLast] == currentValues[state.activeLast - 1]) {
+		state.activeLast--;
+	}
+
+	// Constant data, nothing will change
+	if (state.activeFirst == state.activeLast) {
+		state.activeFirst = size;
+		state.activeLast = -1;
+	}
+}
+
+template <typename T>
+void AbstractScheme<T>::advanceActiveRegion(SimulationState<T>& state) const
+{
+	int size = state.currentValues.size();
+
+	if (!trackActiveRegion || isPeriodic()) {
+		state.activeFirst = 0;
+		state.activeLast = size - 1;
+		return;
+	}
+
+	if (state.activeFirst > state.activeLast) {
+		return;
+	}
+
+	// The margin is limited to the grid, the implicit schemes have an unbounded stencil
+	auto margin = std::min(std::max(stencilRadius(), (int)std::ceil(fabs(u) * state.deltaT / state.deltaX)), size);
+
+	state.activeFirst = std::max(state.activeFirst - margin, 0);
+	state.activeLast = std::min(state.activeLast + margin, size - 1);
+}
+
+template <typename T>
+void AbstractScheme<T>::evaluate(std::function< double(double) > boundaryFunction, std::ostream& stream, bool gridValues) const
+{
+	evaluate(std::make_shared<FunctionAdapter>(boundaryFunction), stream, gridValues);
+}
+
+template <typename T>
+void AbstractScheme<T>::evaluate(std::shared_ptr<const BatchFunction> boundaryFunction, std::ostream& stream, bool gridValues) const
+{
+	auto state = createState();
+
+	evaluate(*state, boundaryFunction, stream, gridValues);
+}
+
+template <typename T>
+void AbstractScheme<T>::evaluate(SimulationState<T>& state, std::shared_ptr<const BatchFunction> boundaryFunction, std::ostream& stream, bool gridValues) const
 {
 	if (analyticalFunction == nullptr) {
 		throw UninitializedFunctionException();
 	}
 
-	std::vector<double> analytical, numerical, difference;
+	TimeStepper<T> stepper(*this, state, boundaryFunction, divergenceCheckInterval);
 
-	boundaryCondition(boundaryFunction);
+	// The diverging runs are stopped at the next checkpoint instead of running until the time frame
+	stepper.setDivergenceLimit(divergenceFactor);
+	stepper.next();
 
 	// Write the user defined result's to the result.txt
-	if (_stream == nullptr) {
+	if (!gridValues) {
 		stream << "\n-----------------------\n" << name << "\n-----------------------\n\n";
 	}
-	
-	for (auto i = deltaT; i <= t; i += deltaT) {
-		analytical = calculateAnalytical(i);
-		numerical = calculateIteration(i);
 
-		std::transform(analytical.begin(), analytical.end(), numerical.begin(), std::back_inserter(difference), [](double a, double b) { return fabs(a - b); });
+	// Only the last time frame is written, the errors are not needed before
+	while (stepper.next()) {
+	}
 
-		if (i >= t - deltaT) {
-			writeToStream(difference, analytical, numerical, i, _stream);
+	if (stepper.getStatus() == TimeStepper<T>::Status::Cancelled) {
+		stream << stepper.getReason() << std::endl;
+		return;
+	}
+
+	if (state.timeSteps > 0) {
+		auto i = state.timeSteps * state.deltaT;
+		auto& values = stepper.current().values;
+
+		// Outside of the active region both solutions are the same constants, so their difference is zero.
+		// The grid values are written to the files, so in that case every point is needed.
+		auto first = 0, last = state.spacePoints;
+
+		if (!gridValues && state.activeFirst <= state.activeLast) {
+			first = state.activeFirst;
+			last = state.activeLast;
 		}
 
-		difference.clear();
+		// The vectors are sized once, so nothing is left behind in the arena by the growth of a vector
+		ArenaAllocator<double> allocator(&state.arena);
+		auto analytical = calculateAnalytical(state, i, first, last);
+		ArenaVector numerical(values.begin() + first, values.begin() + last + 1, allocator);
+		ArenaVector difference(analytical.size(), 0.0, allocator);
+
+		std::transform(analytical.begin(), analytical.end(), numerical.begin(), difference.begin(), [](double a, double b) { return fabs(a - b); });
+
+		writeToStream(state, difference, analytical, numerical, first, i, stream, gridValues);
+	}
+
+	if (!gridValues) {
+		report(state, stream);
 	}
 }
 
-void AbstractScheme::writeToStream(std::vector<double>& difference, std::vector<double>& analytical, std::vector<double>& numerical, double time, std::ostream *_stream)
+template <typename T>
+void AbstractScheme<T>::recordSnapshots(SimulationState<T>& state, std::shared_ptr<const BatchFunction> initialFunction, SnapshotWriter& writer, int interval) const
+{
+	std::vector<double> level;
+
+	initialise(state, initialFunction);
+
+	level.assign(state.currentValues.begin(), state.currentValues.end());
+	writer.write(0, level.data());
+
+	interval = std::max(interval, 1);
+
+	for (auto step = 1; step <= state.timeSteps; step++) {
+		auto& values = advance(state, step);
+
+		if (step % interval == 0 || step == state.timeSteps) {
+			level.assign(values.begin(), values.end());
+			writer.write(step * state.deltaT, level.data());
+		}
+	}
+}
+
+template <typename T>
+void AbstractScheme<T>::writeToStream(const SimulationState<T>& state, ArenaVector& difference, ArenaVector& analytical, ArenaVector& numerical, int first, double time, std::ostream& stream, bool gridValues) const
 {
 	// Write the user defined result's to the userresult.txt
-	if (_stream == nullptr) {
+	if (!gridValues) {
 		stream << "t = " << time << std::endl;
 		stream << "infinite norm is " << VectorNorms<double>::infiniteNorm(&difference) << std::endl;
 		stream << "1st norm is " << VectorNorms<double>::pNorm(&difference, 1) << std::endl;
@@ -87,127 +296,256 @@ void AbstractScheme::writeToStream(std::vector<double>& difference, std::vector<
 	}
 	else
 	{
-		*_stream << "infinite " << VectorNorms<double>::infiniteNorm(&difference) << std::endl;
-		*_stream << "1st " << VectorNorms<double>::pNorm(&difference, 1) << std::endl;
-		*_stream << "2nd " << VectorNorms<double>::pNorm(&difference, 2) << std::endl << std::endl;
-		*_stream << "grid, Analytical, Numerical" << std::endl;
+		stream << "infinite " << VectorNorms<double>::infiniteNorm(&difference) << std::endl;
+		stream << "1st " << VectorNorms<double>::pNorm(&difference, 1) << std::endl;
+		stream << "2nd " << VectorNorms<double>::pNorm(&difference, 2) << std::endl << std::endl;
+		stream << "grid, Analytical, Numerical" << std::endl;
 	}
 
-	auto x = xStart;
+	if (!gridValues) {
+		return;
+	}
 
 	for (auto i = 0; i < analytical.size(); i++) {
-		if (_stream != nullptr) {
-			*_stream << x << ", " << analytical[i] << ", " << numerical[i] << std::endl;
-		}
-
-		x += deltaX;
+		stream << (*state.grid)[first + i] << ", " << analytical[i] << ", " << numerical[i] << std::endl;
 	}
 }
 
-void AbstractScheme::setFunction(std::function<double(double, double)> function, int _left, int _right)
+template <typename T>
+void AbstractScheme<T>::setFunction(std::shared_ptr<const BatchFunction> function, int _left, int _right)
 {
 	analyticalFunction = function;
 	left = _left;
 	right = _right;
 }
 
-void AbstractScheme::calculateAllVariations(std::string functionName, std::function< double(double) > boundaryFunction) 
-{
-	std::ofstream stream;
-
-	spacePoints = 100, t = 5, cfl = 0.5;
-	calculateDeltas();
-	stream.open("results/" + name + " " + functionName + " " + std::to_string(spacePoints) + " " + std::to_string((int)t) + " " + std::to_string(cfl).substr(0, 4) + ".txt");
-	evaluate(boundaryFunction, &stream);
-	stream.close();
-
-	cfl = 0.99;
-	calculateDeltas();
-	stream.open("results/" + name + " " + functionName + " " + std::to_string(spacePoints) + " " + std::to_string((int)t) + " " + std::to_string(cfl).substr(0, 4) + ".txt");
-	evaluate(boundaryFunction, &stream);
-	stream.close();
-
-	cfl = 1.01;
-	calculateDeltas();
-	stream.open("results/" + name + " " + functionName + " " + std::to_string(spacePoints) + " " + std::to_string((int)t) + " " + std::to_string(cfl).substr(0, 4) + ".txt");
-	evaluate(boundaryFunction, &stream);
-	stream.close();
-
-	cfl = 1.99;
-	calculateDeltas();
-	stream.open("results/" + name + " " + functionName + " " + std::to_string(spacePoints) + " " + std::to_string((int)t) + " " + std::to_string(cfl).substr(0, 4) + ".txt");
-	evaluate(boundaryFunction, &stream);
-	stream.close();
-
-	t = 10, cfl = 0.5;
-	calculateDeltas();
-	stream.open("results/" + name + " " + functionName + " " + std::to_string(spacePoints) + " " + std::to_string((int)t) + " " + std::to_string(cfl).substr(0, 4) + ".txt");
-	evaluate(boundaryFunction, &stream);
-	stream.close();
-
-	cfl = 0.99;
-	calculateDeltas();
-	stream.open("results/" + name + " " + functionName + " " + std::to_string(spacePoints) + " " + std::to_string((int)t) + " " + std::to_string(cfl).substr(0, 4) + ".txt");
-	evaluate(boundaryFunction, &stream);
-	stream.close();
-
-	cfl = 1.01;
-	calculateDeltas();
-	stream.open("results/" + name + " " + functionName + " " + std::to_string(spacePoints) + " " + std::to_string((int)t) + " " + std::to_string(cfl).substr(0, 4) + ".txt");
-	evaluate(boundaryFunction, &stream);
-	stream.close();
-
-	cfl = 1.99;
-	calculateDeltas();
-	stream.open("results/" + name + " " + functionName + " " + std::to_string(spacePoints) + " " + std::to_string((int)t) + " " + std::to_string(cfl).substr(0, 4) + ".txt");
-	evaluate(boundaryFunction, &stream);
-	stream.close();
-
-	spacePoints = 200, t = 5, cfl = 0.5;
-	calculateDeltas();
-	stream.open("results/" + name + " " + functionName + " " + std::to_string(spacePoints) + " " + std::to_string((int)t) + " " + std::to_string(cfl).substr(0, 4) + ".txt");
-	evaluate(boundaryFunction, &stream);
-	stream.close();
-
-	cfl = 0.99;
-	calculateDeltas();
-	stream.open("results/" + name + " " + functionName + " " + std::to_string(spacePoints) + " " + std::to_string((int)t) + " " + std::to_string(cfl).substr(0, 4) + ".txt");
-	evaluate(boundaryFunction, &stream);
-	stream.close();
-
-	cfl = 1.01;
-	calculateDeltas();
-	stream.open("results/" + name + " " + functionName + " " + std::to_string(spacePoints) + " " + std::to_string((int)t) + " " + std::to_string(cfl).substr(0, 4) + ".txt");
-	evaluate(boundaryFunction, &stream);
-	stream.close();
-
-	cfl = 1.99;
-	calculateDeltas();
-	stream.open("results/" + name + " " + functionName + " " + std::to_string(spacePoints) + " " + std::to_string((int)t) + " " + std::to_string(cfl).substr(0, 4) + ".txt");
-	evaluate(boundaryFunction, &stream);
-	stream.close();
-
-	spacePoints = 400, t = 5, cfl = 0.5;
-	calculateDeltas();
-	stream.open("results/" + name + " " + functionName + " " + std::to_string(spacePoints) + " " + std::to_string((int)t) + " " + std::to_string(cfl).substr(0, 4) + ".txt");
-	evaluate(boundaryFunction, &stream);
-	stream.close();
-
-	cfl = 0.99;
-	calculateDeltas();
-	stream.open("results/" + name + " " + functionName + " " + std::to_string(spacePoints) + " " + std::to_string((int)t) + " " + std::to_string(cfl).substr(0, 4) + ".txt");
-	evaluate(boundaryFunction, &stream);
-	stream.close();
-
-	cfl = 1.01;
-	calculateDeltas();
-	stream.open("results/" + name + " " + functionName + " " + std::to_string(spacePoints) + " " + std::to_string((int)t) + " " + std::to_string(cfl).substr(0, 4) + ".txt");
-	evaluate(boundaryFunction, &stream);
-	stream.close();
-
-	cfl = 1.99;
-	calculateDeltas();
-	stream.open("results/" + name + " " + functionName + " " + std::to_string(spacePoints) + " " + std::to_string((int)t) + " " + std::to_string(cfl).substr(0, 4) + ".txt");
-	evaluate(boundaryFunction, &stream);
-	stream.close();
-}
\ No newline at end of file
+template <typename T>
+void AbstractScheme<T>::setFunction(std::function<double(double, double)> function, int _left, int _right)
+{
+	setFunction(function ? std::make_shared<FunctionAdapter>(function) : nullptr, _left, _right);
+}
+
+template <typename T>
+void AbstractScheme<T>::setActiveRegionTracking(bool enabled)
+{
+	trackActiveRegion = enabled;
+}
+
+template <typename T>
+void AbstractScheme<T>::initialise(SimulationState<T>& state, std::shared_ptr<const BatchFunction> initialFunction) const
+{
+	checkStability(state.cfl);
+	boundaryCondition(state, *initialFunction);
+	prepare(state, initialFunction);
+	initialiseActiveRegion(state);
+}
+
+template <typename T>
+const std::vector<T>& AbstractScheme<T>::advance(SimulationState<T>& state, int step) const
+{
+	advanceActiveRegion(state);
+
+	return calculateIteration(state, step * state.deltaT);
+}
+
+template <typename T>
+int AbstractScheme<T>::getTimeSteps() const
+{
+	// The tolerance keeps the last step when t is a multiple of deltaT
+	return (int)std::floor(t / getDeltaT() + 1e-9);
+}
+
+template <typename T>
+double AbstractScheme<T>::getDeltaT() const
+{
+	return stepLength(cfl, getGrid()->getDelta(), t);
+}
+
+template <typename T>
+const std::vector<T>& AbstractScheme<T>::propagate(SimulationState<T>& state, const std::vector<T>& initial, double duration) const
+{
+	auto steps = std::max((int)std::ceil(duration / state.deltaT - 1e-9), 1);
+	auto userDeltaT = state.deltaT;
+
+	state.deltaT = duration / steps;
+
+	checkStability(u * state.deltaT / state.deltaX);
+
+	state.currentValues = initial;
+	state.nextValues = initial;
+	prepare(state, nullptr);
+	initialiseActiveRegion(state);
+
+	for (auto i = 1; i <= steps; i++) {
+		advanceActiveRegion(state);
+		calculateIteration(state, i * state.deltaT);
+	}
+
+	state.deltaT = userDeltaT;
+
+	return state.currentValues;
+}
+
+template <typename T>
+int AbstractScheme<T>::getSpacePoints() const
+{
+	return spacePoints;
+}
+
+template <typename T>
+double AbstractScheme<T>::getVelocity() const
+{
+	return u;
+}
+
+template <typename T>
+int AbstractScheme<T>::getLeftBoundary() const
+{
+	return left;
+}
+
+template <typename T>
+int AbstractScheme<T>::getRightBoundary() const
+{
+	return right;
+}
+
+template <typename T>
+int AbstractScheme<T>::getStencilRadius() const
+{
+	return stencilRadius();
+}
+
+template <typename T>
+bool AbstractScheme<T>::isLocal() const
+{
+	return true;
+}
+
+template <typename T>
+bool AbstractScheme<T>::isPeriodic() const
+{
+	return false;
+}
+
+template <typename T>
+std::shared_ptr<const BatchFunction> AbstractScheme<T>::exactFunction(std::shared_ptr<const BatchFunction> function) const
+{
+	if (!isPeriodic()) {
+		return function;
+	}
+
+	return std::make_shared<PeriodicFunction>(function, xStart, xEnd, u);
+}
+
+template <typename T>
+std::vector<Stencil> AbstractScheme<T>::getStencils(double cfl) const
+{
+	return std::vector<Stencil>();
+}
+
+template <typename T>
+void AbstractScheme<T>::checkStability(double _cfl) const
+{
+	auto amplification = StabilityAnalysis<T>::maxAmplification(*this, _cfl);
+
+	if (!StabilityAnalysis<T>::isStable(*this, _cfl)) {
+		throw UnstableSchemeException(name, _cfl, amplification, StabilityAnalysis<T>::maxStableCfl(*this));
+	}
+}
+
+template <typename T>
+std::shared_ptr<const Grid> AbstractScheme<T>::getGrid() const
+{
+	return Grid::get(xStart, xEnd, spacePoints);
+}
+
+template <typename T>
+std::string AbstractScheme<T>::getName() const
+{
+	return name;
+}
+
+template <typename T>
+std::string AbstractScheme<T>::getIdentity() const
+{
+	std::ostringstream identity;
+
+	identity.precision(17);
+	identity << name << ", " << (sizeof(T) == sizeof(float) ? "float" : "double") << ", " << xStart << " " << xEnd << " " << u << " " << left << " " << right;
+
+	return identity.str();
+}
+
+template <typename T>
+void AbstractScheme<T>::calculateAllVariations(std::string functionName, std::shared_ptr<const BatchFunction> boundaryFunction, ResultCache* cache) const
+{
+	// The number of intervals and the timeframes, every one is calculated with all Courant numbers
+	const std::pair<int, double> grids[] = { { 100, 5 }, { 100, 10 }, { 200, 5 }, { 400, 5 } };
+	const double cfls[] = { 0.5, 0.99, 1.01, 1.99 };
+
+	std::vector<std::future<void>> futures;
+
+	for (auto& grid : grids) {
+		for (auto cfl : cfls) {
+			futures.push_back(ThreadPool::shared().submit([this, grid, cfl, functionName, boundaryFunction, cache] {
+				auto path = "results/" + name + " " + functionName + " " + std::to_string(grid.first) + " " + std::to_string((int)grid.second) + " " + std::to_string(cfl).substr(0, 4) + ".txt";
+				std::ostringstream key;
+				std::string content;
+
+				// The diverging runs are not calculated, the file explains the instability instead
+				try {
+					checkStability(cfl);
+				}
+				catch (const UnstableSchemeException& e) {
+					std::ofstream(path) << e.what() << std::endl;
+					return;
+				}
+
+				// Only the runs of the known functions can be cached
+				if (cache != nullptr && analyticalFunction != nullptr && !analyticalFunction->getIdentity().empty() && !boundaryFunction->getIdentity().empty()) {
+					key.precision(17);
+					key << getIdentity() << "\n" << analyticalFunction->getIdentity() << "\n" << boundaryFunction->getIdentity() << "\n" << grid.first << " " << grid.second << " " << cfl;
+				}
+
+				if (key.tellp() > 0 && cache->load(key.str(), content)) {
+					std::ofstream(path) << content;
+					return;
+				}
+
+				auto state = createState(grid.first, grid.second, cfl);
+				std::ostringstream stream;
+
+				evaluate(*state, boundaryFunction, stream, true);
+				content = stream.str();
+				std::ofstream(path) << content;
+
+				if (key.tellp() > 0) {
+					cache->store(key.str(), content);
+				}
+			}));
+		}
+	}
+
+	// Wait for every run before passing on the first error, the runs use this scheme
+	std::exception_ptr error;
+
+	for (auto& future : futures) {
+		try {
+			future.get();
+		}
+		catch (...) {
+			if (!error) {
+				error = std::current_exception();
+			}
+		}
+	}
+
+	if (error) {
+		std::rethrow_exception(error);
+	}
+}
+
+// Explicit instantiation for the supported value types
+template class AbstractScheme<float>;
+template class AbstractScheme<double>;
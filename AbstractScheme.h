@@ -2,6 +2,14 @@
 
 #include <vector>
 #include <functional>
+#include <memory>
+#include "ArenaAllocator.h"
+#include "BatchFunction.h"
+#include "Grid.h"
+#include "ResultCache.h"
+#include "SimulationState.h"
+#include "SnapshotWriter.h"
+#include "Stencil.h"
 
 /*! \mainpage Linear advection equation solver
 *
@@ -23,49 +31,123 @@
 * \n-calculateIteration function, the interface for the exact schemes
 * \n-evaluate function to resolves the schemes
 * \n-setFunction procedure to change the analytical function and the boundary values
+*
+* The state of the scheme is stored with the T value type (float or double, default value is double),
+* \nthe analytical values and the error norms are always calculated in double precision.
+* \nThe schemes are explicitly instantiated for float and double in their source files.
+*
+* The scheme is an immutable description of the method, the data of a run is kept in a SimulationState.
+* \nAfter the configuration (setFunction, setActiveRegionTracking) the const functions can be called
+* \nconcurrently, every run with its own state and output stream.
 */
+template <typename T = double>
 class AbstractScheme
 {
 	/**
-	* Private method that calculates the value of deltaX and deltaT based on the user's input
+	* The vectors of the analytical values and the errors of an evaluation, their storage is taken from the arena of the state
 	*/
-	void calculateDeltas();
+	typedef std::vector<double, ArenaAllocator<double> > ArenaVector;
 
 	/**
 	* Private method that calculates the boundary values for a scheme
-	* @param boundaryFunction std::function< double(double) > - Lambda function used to calculate the boundary values
+	* @param state SimulationState<T>& - The state of the run
+	* @param boundaryFunction const BatchFunction& - Function used to calculate the boundary values
 	*/
-	void boundaryCondition(std::function< double(double) > boundaryFunction);
+	void boundaryCondition(SimulationState<T>& state, const BatchFunction& boundaryFunction) const;
 
 	/**
 	* Private method that calculates the analytical values for a function at the given time frame
-	* It returns a vector of doubles containing the exact solution
+	* It returns a vector of doubles containing the exact solution for the first ... last grid points
+	* @param state SimulationState<T>& - The state of the run, the vector is allocated in its arena
 	* @param double t - The current time frame
-	* @return std::vector<double> - The calculated analytical values
+	* @param first int - The index of the first grid point
+	* @param last int - The index of the last grid point
+	* @return ArenaVector - The calculated analytical values
+	*/
+	ArenaVector calculateAnalytical(SimulationState<T>& state, double t, int first, int last) const;
+
+	/**
+	* Private method that returns the values of a batch function at t = 0 on the given grid
+	* The first and last values are the left and right boundary values (the first value is repeated on the periodic domains)
+	*/
+	std::vector<T> discretise(const Grid& grid, const BatchFunction& function) const;
+
+	/**
+	* Private method that finds the cells where the initial values are not constant
+	* If the tracking is disabled the active region is the whole grid
+	* @param state SimulationState<T>& - The state of the run
+	*/
+	void initialiseActiveRegion(SimulationState<T>& state) const;
+
+	/**
+	* Private method that grows the active region by the distance the data can travel in one time step,
+	* which is the stencil radius or the CFL number of cells, whichever is larger
+	* @param state SimulationState<T>& - The state of the run
 	*/
-	std::vector<double> calculateAnalytical(double t);
+	void advanceActiveRegion(SimulationState<T>& state) const;
 
 	/**
 	* Private method that outputs the results to the given stream
-	* The constructors for the exact schemes have an optional stream parameter, if it is not supplied
-	* the default value will be used which is std::cout
-	* @param difference vector<double> - Contains the error values
+	* @param state const SimulationState<T>& - The state of the run
+	* @param difference ArenaVector& - Contains the error values
+	* @param analytical ArenaVector&, numerical ArenaVector& - The analytical and numerical values
+	* @param first int - The index of the grid point of the first values
 	* @param time double - The current time frame
+	* @param stream std::ostream& - The stream to write the results to
+	* @param gridValues bool - True to write the norms and the grid values, false to write the labelled norms only
 	*/
-	void writeToStream(std::vector<double>& difference, std::vector<double>& analytical, std::vector<double>& numerical, double time, std::ostream *_stream);
+	void writeToStream(const SimulationState<T>& state, ArenaVector& difference, ArenaVector& analytical, ArenaVector& numerical, int first, double time, std::ostream& stream, bool gridValues) const;
 
 protected:
 	std::string name;
-	std::ostream& stream;
-	std::vector<double> currentValues;
 	int spacePoints, boundary, left, right;
-	double xStart, xEnd, deltaX, t, deltaT, u, cfl;
-	std::function< double(double , double) > analyticalFunction;
+	bool trackActiveRegion;
+	double xStart, xEnd, t, u, cfl;
+	std::shared_ptr<const BatchFunction> analyticalFunction;
+
+	/**
+	* Virtual function that returns the number of cells on each side of a cell the new value depends on
+	* @return int - The radius of the stencil (default value is 1)
+	*/
+	virtual int stencilRadius() const;
+
+	/**
+	* Virtual function that returns the length of the time steps
+	* The schemes exact in time can take the whole time frame in one step (default value is cfl * deltaX / u)
+	* @param cfl double - The Courant number
+	* @param deltaX double - The space step
+	* @param t double - The timeframe until the calculations should be executed
+	* @return double - The time step
+	*/
+	virtual double stepLength(double cfl, double deltaX, double t) const;
+
+	/**
+	* Virtual function that creates the empty state of a run
+	* The schemes with own per-run data return their derived state (default value is a SimulationState<T>)
+	* @return std::unique_ptr<SimulationState<T>> - The new state
+	*/
+	virtual std::unique_ptr<SimulationState<T>> allocateState() const;
+
+	/**
+	* Virtual function called before the first time step of every run
+	* The schemes can prepare their time step dependent data here (default implementation does nothing)
+	* @param state SimulationState<T>& - The state of the run
+	* @param initialFunction std::shared_ptr<const BatchFunction> - The initial function, nullptr if the initial values are given directly
+	*/
+	virtual void prepare(SimulationState<T>& state, std::shared_ptr<const BatchFunction> initialFunction) const;
+
+	/**
+	* Virtual function called at the end of the evaluation to write the scheme specific results
+	* (default implementation does nothing)
+	* @param state const SimulationState<T>& - The state of the run
+	* @param stream std::ostream& - The stream to write the results to
+	*/
+	virtual void report(const SimulationState<T>& state, std::ostream& stream) const;
 
 public:
 	/**
 	* Constructor to provide a common creation procedure for the schemes
-	* @param file std::ostream& - The stream to write the results to (default value is std::cout)
+	* The scheme does not keep an output stream, the results are written to the stream passed to evaluate
 	* @param name std::string - The name of the scheme
 	* @param xStart double - Beginning of the space dimension
 	* @param xEnd double - End of the space dimension
@@ -73,7 +155,7 @@ public:
 	* @param spacePoints int - The number of intervals in the space dimension
 	* @param u double - The velocity of the wave
 	*/
-	AbstractScheme(std::ostream& stream, std::string name, double xStart, double xEnd, double t, int spacePoints, double u, double cfl);
+	AbstractScheme(std::string name, double xStart, double xEnd, double t, int spacePoints, double u, double cfl);
 
 	/**
 	* Virtual destructor to allow the deletion of derived classes through a pointer to the base class
@@ -82,28 +164,236 @@ public:
 
 	/**
 	* Pure virtual function to approximate the current values at the given time frame
-	* @param u double - The velocity of the wave
-	* @return std::vector<double> - The calculated analytical values
+	* The explicit schemes only have to update the activeFirst ... activeLast cells of the state
+	* @param state SimulationState<T>& - The state of the run
+	* @param double t - The current time frame
+	* @return const std::vector<T>& - The calculated numerical values
+	*/
+	virtual const std::vector<T>& calculateIteration(SimulationState<T>& state, double t) const = 0;
+
+	/**
+	* Function that creates the state of a run with the parameters of the scheme
+	* @return std::unique_ptr<SimulationState<T>> - The new state
+	*/
+	std::unique_ptr<SimulationState<T>> createState() const;
+
+	/**
+	* Function that creates the state of a run with the given parameters
+	* @param spacePoints int - The number of intervals in the space dimension
+	* @param t double - The timeframe until the calculations should be executed
+	* @param cfl double - The Courant number
+	* @return std::unique_ptr<SimulationState<T>> - The new state
+	*/
+	std::unique_ptr<SimulationState<T>> createState(int spacePoints, double t, double cfl) const;
+
+	/**
+	* Void function to approximate the current values at the given time frame with a new state
+	* @param boundaryFunction std::shared_ptr<const BatchFunction> - The boundary function to start the calculations (evaluated at t = 0)
+	* @param stream std::ostream& - The stream to write the results to
+	* @param gridValues bool - True to write the norms and the values of every grid point, false to write the labelled norms
+	* and the scheme specific results (default value is false)
+	*/
+	void evaluate(std::shared_ptr<const BatchFunction> boundaryFunction, std::ostream& stream, bool gridValues = false) const;
+
+	/**
+	* Void function to approximate the current values at the given time frame
+	* The run is pulled through a TimeStepper, it is cancelled when the values diverge (not finite or growing by 1000 times),
+	* then the stream gets the reason instead of the norms
+	* @param state SimulationState<T>& - The state of the run
+	* @param boundaryFunction std::shared_ptr<const BatchFunction> - The boundary function to start the calculations (evaluated at t = 0)
+	* @param stream std::ostream& - The stream to write the results to
+	* @param gridValues bool - True to write the norms and the values of every grid point (default value is false)
 	*/
-	virtual std::vector<double> calculateIteration(double t) = 0;
+	void evaluate(SimulationState<T>& state, std::shared_ptr<const BatchFunction> boundaryFunction, std::ostream& stream, bool gridValues = false) const;
 
 	/**
-	* Virtual void function to approximate the current values at the given time frame
+	* Void function to approximate the current values at the given time frame
 	* @param boundaryFunction std::function< double(double) > - The boundary function to start the calculations
+	* @param stream std::ostream& - The stream to write the results to
+	* @param gridValues bool - True to write the norms and the values of every grid point (default value is false)
+	*/
+	void evaluate(std::function< double(double) > boundaryFunction, std::ostream& stream, bool gridValues = false) const;
+
+	/**
+	* Void function to approximate the values and record the time series of the grid values
+	* The initial values, every interval-th time level and the last one are appended to the writer
+	* @param state SimulationState<T>& - The state of the run
+	* @param initialFunction std::shared_ptr<const BatchFunction> - The function of the initial values (evaluated at t = 0)
+	* @param writer SnapshotWriter& - The writer of the compressed time levels, created with spacePoints + 1 values
+	* @param interval int - The number of the time steps between two recorded levels (default value is 1)
 	*/
-	virtual void evaluate(std::function< double(double) > boundaryFunction, std::ostream *stream = nullptr);
+	void recordSnapshots(SimulationState<T>& state, std::shared_ptr<const BatchFunction> initialFunction, SnapshotWriter& writer, int interval = 1) const;
 
 	/**
 	* Void function to calculate all variatons according to the input parameters
+	* The variations are independent runs, they are executed concurrently on the shared thread pool
+	* With a cache only the missing variations are calculated, the others are copied from the cache
+	* The unstable variations are not calculated, their files contain the result of the stability analysis
 	* @param functionName string - The name of the currently evaluated function
+	* @param boundaryFunction std::shared_ptr<const BatchFunction> - The boundary function to start the calculations
+	* @param cache ResultCache* - The cache of the result files (default value is nullptr, no caching)
 	*/
-	void calculateAllVariations(std::string functionName, std::function< double(double) > boundaryFunction);
+	void calculateAllVariations(std::string functionName, std::shared_ptr<const BatchFunction> boundaryFunction, ResultCache* cache = nullptr) const;
 	
 	/**
 	* Void function to change the analytical function and the boundary values for a scheme
-	* @param analytical std::function< double(double) > - The boundary function to start the calculations
+	* It changes the configuration, so it must not be called while a run is in progress
+	* @param analytical std::shared_ptr<const BatchFunction> - The analytical function evaluated for the whole grid at once
+	* @param left int - The left boundary value
+	* @param right int - The right boundary value
+	*/
+	void setFunction(std::shared_ptr<const BatchFunction> analytical, int left, int right);
+
+	/**
+	* Void function to change the analytical function and the boundary values for a scheme
+	* @param analytical std::function< double(double, double) > - The analytical function evaluated point by point
 	* @param left int - The left boundary value
 	* @param right int - The right boundary value
 	*/
 	void setFunction(std::function< double(double, double) > analytical, int left, int right);
-};
\ No newline at end of file
+
+	/**
+	* Void function to enable or disable the tracking of the active region
+	* When enabled the quiescent cells are skipped by the explicit schemes and by the error norms,
+	* the results are the same as the ones of the full update
+	* @param enabled bool - True to enable the tracking
+	*/
+	void setActiveRegionTracking(bool enabled);
+
+	/**
+	* Void function to set the initial values and prepare the scheme for the time steps
+	* Throws UnstableSchemeException if the scheme would diverge with the Courant number of the state
+	* @param state SimulationState<T>& - The state of the run
+	* @param initialFunction std::shared_ptr<const BatchFunction> - The function of the initial values (evaluated at t = 0)
+	*/
+	void initialise(SimulationState<T>& state, std::shared_ptr<const BatchFunction> initialFunction) const;
+
+	/**
+	* Function that advances the values of a state with one time step
+	* The states created with the same grid, t and CFL number can be advanced in lock-step
+	* @param state SimulationState<T>& - The state of the run
+	* @param step int - The index of the time step (1 ... timeSteps), the time frame is step * deltaT
+	* @return const std::vector<T>& - The values after the time step
+	*/
+	const std::vector<T>& advance(SimulationState<T>& state, int step) const;
+
+	/**
+	* Function that returns the number of the time steps until t with the parameters of the scheme
+	* @return int - The number of the time steps
+	*/
+	int getTimeSteps() const;
+
+	/**
+	* Function that returns the length of the time steps with the parameters of the scheme
+	* @return double - The time step
+	*/
+	double getDeltaT() const;
+
+	/**
+	* Function that advances the given values with the scheme without comparing to the analytical solution
+	* The time step is shortened to reach the end of the interval exactly, so the CFL number never grows
+	* Throws UnstableSchemeException if the scheme would diverge with the shortened time step
+	* @param state SimulationState<T>& - The state of the run
+	* @param initial std::vector<T> - The values on the grid of the state at the beginning of the interval
+	* @param duration double - The length of the time interval
+	* @return const std::vector<T>& - The values at the end of the interval
+	*/
+	const std::vector<T>& propagate(SimulationState<T>& state, const std::vector<T>& initial, double duration) const;
+
+	/**
+	* Function that returns the values of a function on the grid of the scheme
+	* The first and last values are the left and right boundary values (the first value is repeated on the periodic domains)
+	* @param function std::function< double(double) > - The function to be sampled
+	* @return std::vector<T> - The values on the grid
+	*/
+	std::vector<T> discretise(std::function< double(double) > function) const;
+
+	/**
+	* Function that returns the values of a batch function at t = 0 on the grid of the scheme
+	* The first and last values are the left and right boundary values (the first value is repeated on the periodic domains)
+	* @param function const BatchFunction& - The function to be sampled
+	* @return std::vector<T> - The values on the grid
+	*/
+	std::vector<T> discretise(const BatchFunction& function) const;
+
+	/**
+	* Function that returns the number of intervals in the space dimension
+	* @return int - The number of intervals
+	*/
+	int getSpacePoints() const;
+
+	/**
+	* Function that returns the velocity of the wave
+	* @return double - The velocity
+	*/
+	double getVelocity() const;
+
+	/**
+	* Functions that return the boundary values set by setFunction
+	* @return int - The left or right boundary value
+	*/
+	int getLeftBoundary() const;
+	int getRightBoundary() const;
+
+	/**
+	* Function that returns the number of cells on each side of a cell the new value depends on
+	* @return int - The radius of the stencil
+	*/
+	int getStencilRadius() const;
+
+	/**
+	* Virtual function that tells if a time step only depends on the previous values within the stencil radius
+	* The local schemes can advance separate windows of the grid with separate states (default value is true)
+	* @return bool - True if the scheme is local
+	*/
+	virtual bool isLocal() const;
+
+	/**
+	* Virtual function that tells if the domain of the scheme is periodic (default value is false)
+	* On a periodic domain the last grid point is the image of the first one, the boundary values are not used,
+	* the analytical solution is the periodic extension of the wave and the active region is the whole grid
+	* @return bool - True if the domain is periodic
+	*/
+	virtual bool isPeriodic() const;
+
+	/**
+	* Function that returns the exact solution of a travelling wave on the domain of the scheme
+	* @param function std::shared_ptr<const BatchFunction> - The wave on the unbounded domain
+	* @return std::shared_ptr<const BatchFunction> - The function itself, or its periodic extension on the periodic domains
+	*/
+	std::shared_ptr<const BatchFunction> exactFunction(std::shared_ptr<const BatchFunction> function) const;
+
+	/**
+	* Virtual function that returns the stencil coefficients of the scheme for the von Neumann stability analysis
+	* The nonlinear schemes return the linear schemes they are bounded by (default value is empty, not analysed)
+	* @param cfl double - The Courant number
+	* @return std::vector<Stencil> - The stencils of the scheme
+	*/
+	virtual std::vector<Stencil> getStencils(double cfl) const;
+
+	/**
+	* Void function that checks the stability of the scheme before a run, so the diverging runs fail fast
+	* Throws UnstableSchemeException if a Fourier mode grows with the Courant number
+	* @param cfl double - The Courant number of the run
+	*/
+	void checkStability(double cfl) const;
+
+	/**
+	* Function that returns the grid of the scheme
+	* @return std::shared_ptr<const Grid> - The shared grid with spacePoints + 1 points
+	*/
+	std::shared_ptr<const Grid> getGrid() const;
+
+	/**
+	* Function that returns the name of the scheme
+	* @return std::string - The name of the scheme
+	*/
+	std::string getName() const;
+
+	/**
+	* Virtual function that returns the name and the parameters shared by all runs of the scheme
+	* The schemes with further parameters extend it, the result cache uses it in the keys
+	* @return std::string - The identity of the scheme
+	*/
+	virtual std::string getIdentity() const;
+};
\ No newline at end of file
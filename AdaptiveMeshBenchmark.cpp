@@ -0,0 +1,52 @@
+#include <chrono>
+#include "AdaptiveMeshBenchmark.h"
+#include "AdaptiveMeshScheme.h"
+#include "GaussianProfile.h"
+#include "StepProfile.h"
+
+// The benchmark problem: the usual domain with a stable Courant number
+static const double benchmarkStart = -50.0, benchmarkEnd = 50.0, benchmarkVelocity = 1.75, benchmarkCfl = 0.5;
+
+void AdaptiveMeshBenchmark::compare(std::ostream& stream, int spacePoints, double t, int maxLevel, std::string name, std::shared_ptr<const BatchFunction> profile, int left, int right)
+{
+	typedef std::chrono::steady_clock clock;
+
+	AdaptiveMeshScheme scheme(benchmarkStart, benchmarkEnd, t, spacePoints, benchmarkVelocity, benchmarkCfl, FluxLimiter::VanLeer, maxLevel);
+	const AbstractScheme<>& base = scheme;
+
+	scheme.setFunction(profile, left, right);
+
+	auto state = scheme.createState();
+	auto start = clock::now();
+
+	scheme.initialise(*state, profile);
+
+	for (auto step = 1; step <= state->timeSteps; step++) {
+		base.advance(*state, step);
+	}
+
+	std::chrono::duration<double> adaptive = clock::now() - start;
+
+	// The uniform grid is advanced from the same initial function inside uniformDifference
+	start = clock::now();
+	auto difference = scheme.uniformDifference(*state);
+	std::chrono::duration<double> uniform = clock::now() - start;
+
+	auto cellUpdates = scheme.getCellUpdates(*state), uniformCellUpdates = scheme.getUniformCellUpdates(*state);
+
+	stream << name << ", " << maxLevel << " levels, " << cellUpdates << " cell updates (uniform finest grid: " << uniformCellUpdates << ", "
+		<< (double)uniformCellUpdates / cellUpdates << "x), " << adaptive.count() << "s (uniform finest grid: " << uniform.count() << "s, "
+		<< uniform.count() / adaptive.count() << "x), difference from the uniform finest grid is " << difference << std::endl;
+}
+
+void AdaptiveMeshBenchmark::run(std::ostream& stream, int spacePoints, double t)
+{
+	stream << "\n-----------------------\nAdaptive mesh benchmark\n-----------------------\n\n";
+
+	for (auto maxLevel = 1; maxLevel <= 3; maxLevel++) {
+		compare(stream, spacePoints, t, maxLevel, "Step", std::make_shared<StepProfile>(benchmarkVelocity), 0, 1);
+		compare(stream, spacePoints, t, maxLevel, "Gaussian", std::make_shared<GaussianProfile>(0.5, benchmarkVelocity), 0, 0);
+	}
+
+	stream << std::endl;
+}
@@ -0,0 +1,45 @@
+#pragma once // Include guard
+
+#include <memory>
+#include <ostream>
+#include "BatchFunction.h"
+
+/**
+* Static class for comparing the adaptive mesh scheme with the uniform grid of its finest resolution
+* The step and the Gaussian pulse are advected with one to three refinement levels, the number of the cell updates,
+* the wall-clock time and the difference from the uniform finest grid are written for both grids
+* \nThe uniform grid costs more than the adaptive run, so the comparison is only run by the --benchmark option of the interactive mode
+*
+* The AdaptiveMeshBenchmark class provides:
+* \n-run function to compare the adaptive and the uniform grids on the given base grid
+*/
+class AdaptiveMeshBenchmark
+{
+	/**
+	* Private method that compares the adaptive mesh scheme with a number of refinement levels to the uniform finest grid
+	* @param stream std::ostream& - The stream to write the results to
+	* @param spacePoints int - The number of intervals of the base grid
+	* @param t double - The timeframe until the calculations should be executed
+	* @param maxLevel int - The number of refinement levels above the base grid
+	* @param name std::string - The name of the profile
+	* @param profile std::shared_ptr<const BatchFunction> - The advected profile
+	* @param left int - The left boundary value
+	* @param right int - The right boundary value
+	*/
+	static void compare(std::ostream& stream, int spacePoints, double t, int maxLevel, std::string name, std::shared_ptr<const BatchFunction> profile, int left, int right);
+
+public:
+	// Delete default member functions to emphasize that the class should only be used to access the static functions.
+	AdaptiveMeshBenchmark() = delete;
+	~AdaptiveMeshBenchmark() = delete;
+	AdaptiveMeshBenchmark(const AdaptiveMeshBenchmark& that) = delete;
+	AdaptiveMeshBenchmark & operator=(const AdaptiveMeshBenchmark&) = delete;
+
+	/**
+	* Static public method that compares the adaptive and the uniform grids for the step and the Gaussian pulse
+	* @param stream std::ostream& - The stream to write the results to
+	* @param spacePoints int - The number of intervals of the base grid
+	* @param t double - The timeframe until the calculations should be executed
+	*/
+	static void run(std::ostream& stream, int spacePoints, double t);
+};
@@ -0,0 +1,292 @@
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include "AdaptiveMeshScheme.h"
+
+AdaptiveMeshScheme::AdaptiveMeshScheme(double xStart, double xEnd, double t, int spacePoints, double u, double cfl,
+	FluxLimiter _limiter, int _maxLevel, double _threshold, int _regridInterval)
+	: AbstractScheme<>("Adaptive Mesh Scheme", xStart, xEnd, t, spacePoints, u, cfl),
+	limiter(_limiter), maxLevel(_maxLevel), regridInterval(std::max(_regridInterval, 1)), threshold(_threshold)
+{
+
+}
+
+double& AdaptiveMeshScheme::node(Patch& patch, int i)
+{
+	return patch.values[i - patch.lo + ghosts];
+}
+
+double AdaptiveMeshScheme::sample(const Patch& parent, int fineIndex, double theta)
+{
+	auto value = [&](int i) {
+		auto k = i - parent.lo + ghosts;
+		return parent.previous.empty() ? parent.values[k] : (1 - theta) * parent.previous[k] + theta * parent.values[k];
+	};
+
+	// Even fine nodes coincide with the coarse nodes, odd ones are linearly interpolated
+	if (fineIndex % 2 == 0) {
+		return value(fineIndex / 2);
+	}
+
+	return 0.5 * (value((fineIndex - 1) / 2) + value((fineIndex + 1) / 2));
+}
+
+int AdaptiveMeshScheme::stencilRadius() const
+{
+	return 2;
+}
+
+std::unique_ptr<SimulationState<>> AdaptiveMeshScheme::allocateState() const
+{
+	return std::unique_ptr<SimulationState<>>(new State());
+}
+
+void AdaptiveMeshScheme::prepare(SimulationState<>& _state, std::shared_ptr<const BatchFunction> initialFunction) const
+{
+	auto& state = static_cast<State&>(_state);
+
+	state.initialFunction = initialFunction;
+	state.gradientScale = 0;
+	state.steps = 0;
+	state.cellUpdates = 0;
+}
+
+void AdaptiveMeshScheme::stepPatch(State& state, Patch& patch) const
+{
+	auto nu = u * state.deltaT / state.deltaX;
+	auto ratio = state.deltaT / state.deltaX;
+	auto first = patch.level == 0 ? 1 : patch.lo;
+	auto last = patch.level == 0 ? state.spacePoints - 1 : patch.hi;
+	auto& fluxes = state.fluxes;
+
+	patch.previous = patch.values;
+
+	auto q = [&](int i) { return patch.previous[i - patch.lo + ghosts]; };
+
+	// fluxes[k] is the flux between the nodes first - 1 + k and first + k
+	fluxes.resize(last - first + 2);
+
+	for (auto i = first - 1; i <= last; i++) {
+		fluxes[i - first + 1] = TVDScheme<>::limitedFlux(q(i - 1), q(i), q(i + 1), q(i + 2), u, nu, limiter);
+	}
+
+	for (auto i = first; i <= last; i++) {
+		node(patch, i) = q(i) - ratio * (fluxes[i - first + 1] - fluxes[i - first]);
+	}
+
+	state.cellUpdates += last - first + 1;
+}
+
+void AdaptiveMeshScheme::advance(State& state, Patch& patch) const
+{
+	stepPatch(state, patch);
+
+	for (auto& child : patch.children) {
+		for (auto sub = 0; sub < 2; sub++) {
+			// Fill the ghost nodes from the parent, interpolated in time
+			for (auto k = 1; k <= ghosts; k++) {
+				node(child, child.lo - k) = sample(patch, child.lo - k, 0.5 * sub);
+				node(child, child.hi + k) = sample(patch, child.hi + k, 0.5 * sub);
+			}
+
+			advance(state, child);
+		}
+
+		// Inject the fine solution to the coarse nodes
+		for (auto i = child.lo; i <= child.hi; i += 2) {
+			node(patch, i / 2) = node(child, i);
+		}
+	}
+}
+
+void AdaptiveMeshScheme::createChild(State& state, Patch& parent, int clo, int chi, std::vector<std::vector<Patch>>& old) const
+{
+	Patch child;
+	auto dx = state.deltaX / (1 << (parent.level + 1));
+
+	child.level = parent.level + 1;
+	child.lo = 2 * clo;
+	child.hi = 2 * chi;
+	child.values.resize(child.hi - child.lo + 1 + 2 * ghosts);
+
+	if (state.steps == 0 && state.initialFunction) {
+		// Sample the initial function on the whole fine patch with one call
+		for (auto i = child.lo - ghosts; i <= child.hi + ghosts; i++) {
+			node(child, i) = xStart + i * dx;
+		}
+
+		state.initialFunction->evaluate(child.values.data(), 0.0, child.values.data(), child.values.size());
+	}
+	else {
+		for (auto i = child.lo - ghosts; i <= child.hi + ghosts; i++) {
+			node(child, i) = sample(parent, i, 1.0);
+		}
+	}
+
+	// Keep the fine solution where the old patches overlap the new one
+	if (child.level < (int)old.size()) {
+		for (auto& previous : old[child.level]) {
+			for (auto i = std::max(child.lo, previous.lo); i <= std::min(child.hi, previous.hi); i++) {
+				node(child, i) = node(previous, i);
+			}
+		}
+	}
+
+	parent.children.push_back(std::move(child));
+}
+
+void AdaptiveMeshScheme::regrid(State& state, Patch& patch, std::vector<std::vector<Patch>>& old) const
+{
+	if (patch.level >= maxLevel || state.gradientScale <= 0) {
+		return;
+	}
+
+	// The children must be nested in the owned nodes of the patch with one node to spare for the ghosts
+	auto first = patch.level == 0 ? 1 : patch.lo + 1;
+	auto last = patch.level == 0 ? state.spacePoints - 1 : patch.hi - 1;
+	auto runStart = -1, runEnd = -1;
+
+	// The fronts travel regridInterval * cfl coarse cells until the next regridding, that is 2^level times more nodes of the patch
+	auto buffer = (regridInterval * (int)std::ceil(std::fabs(u * state.deltaT / state.deltaX)) + ghosts) << patch.level;
+
+	for (auto i = first; i <= last; i++) {
+		if (fabs(node(patch, i + 1) - node(patch, i - 1)) <= threshold * state.gradientScale) {
+			continue;
+		}
+
+		auto lo = std::max(first, i - buffer), hi = std::min(last, i + buffer);
+
+		// Merge the flagged nodes into blocks, small gaps are not worth a new patch
+		if (runStart >= 0 && lo <= runEnd + 2 * ghosts) {
+			runEnd = hi;
+		}
+		else {
+			if (runStart >= 0) {
+				createChild(state, patch, runStart, runEnd, old);
+			}
+
+			runStart = lo;
+			runEnd = hi;
+		}
+	}
+
+	if (runStart >= 0) {
+		createChild(state, patch, runStart, runEnd, old);
+	}
+
+	for (auto& child : patch.children) {
+		regrid(state, child, old);
+	}
+}
+
+const std::vector<double>& AdaptiveMeshScheme::calculateIteration(SimulationState<>& _state, double t) const
+{
+	auto& state = static_cast<State&>(_state);
+	auto& root = state.root;
+
+	if (state.steps == 0) {
+		root.level = 0;
+		root.lo = 0;
+		root.hi = state.spacePoints;
+		root.values.assign(ghosts, (double)left);
+		root.values.insert(root.values.end(), state.currentValues.begin(), state.currentValues.end());
+		root.values.insert(root.values.end(), ghosts, (double)right);
+		root.previous.clear();
+		root.children.clear();
+	}
+
+	if (state.steps % regridInterval == 0) {
+		std::vector<std::vector<Patch>> old(maxLevel + 1);
+
+		// Collect the current patches by level, then rebuild the hierarchy
+		std::function<void(Patch&)> collect = [&](Patch& patch) {
+			for (auto& child : patch.children) {
+				collect(child);
+				old[child.level].push_back(std::move(child));
+			}
+
+			patch.children.clear();
+		};
+		collect(root);
+
+		auto bounds = std::minmax_element(root.values.begin(), root.values.end());
+		state.gradientScale = *bounds.second - *bounds.first;
+
+		regrid(state, root, old);
+	}
+
+	advance(state, root);
+	state.steps++;
+
+	state.currentValues.assign(root.values.begin() + ghosts, root.values.end() - ghosts);
+
+	return state.currentValues;
+}
+
+void AdaptiveMeshScheme::report(const SimulationState<>& state, std::ostream& stream) const
+{
+	stream << "cell updates is " << getCellUpdates(state) << " (uniform finest grid: " << getUniformCellUpdates(state) << ")" << std::endl << std::endl;
+}
+
+long long AdaptiveMeshScheme::getCellUpdates(const SimulationState<>& state) const
+{
+	return static_cast<const State&>(state).cellUpdates;
+}
+
+long long AdaptiveMeshScheme::getUniformCellUpdates(const SimulationState<>& state) const
+{
+	long long ratio = 1LL << maxLevel;
+
+	return static_cast<const State&>(state).steps * ratio * (state.spacePoints * ratio - 1);
+}
+
+double AdaptiveMeshScheme::uniformDifference(const SimulationState<>& _state) const
+{
+	auto& state = static_cast<const State&>(_state);
+	auto ratio = 1 << maxLevel;
+
+	if (!state.initialFunction) {
+		throw std::logic_error("the uniform grid needs the initial function of the run");
+	}
+
+	// The finest level has the same Courant number, so the uniform grid takes ratio steps per coarse step
+	TVDScheme<> uniform(xStart, xEnd, t, state.spacePoints * ratio, u, state.cfl, limiter);
+	uniform.setFunction(analyticalFunction, left, right);
+
+	auto fine = uniform.createState(state.spacePoints * ratio, t, state.cfl);
+	uniform.initialise(*fine, state.initialFunction);
+
+	for (long long step = 1; step <= state.steps * ratio; step++) {
+		uniform.advance(*fine, (int)step);
+	}
+
+	auto difference = 0.0;
+
+	for (auto i = 0; i <= state.spacePoints; i++) {
+		difference = std::max(difference, std::fabs(state.currentValues[i] - fine->currentValues[(std::size_t)i * ratio]));
+	}
+
+	return difference;
+}
+
+std::string AdaptiveMeshScheme::getIdentity() const
+{
+	std::ostringstream identity;
+
+	identity.precision(17);
+	identity << AbstractScheme<>::getIdentity() << ", " << (int)limiter << " " << maxLevel << " " << threshold << " " << regridInterval;
+
+	return identity.str();
+}
+
+bool AdaptiveMeshScheme::isLocal() const
+{
+	return false;
+}
+
+std::vector<Stencil> AdaptiveMeshScheme::getStencils(double cfl) const
+{
+	return TVDScheme<>::linearisedStencils(cfl, limiter);
+}
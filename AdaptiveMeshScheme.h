@@ -0,0 +1,171 @@
+#pragma once // Include guard
+
+#include "AbstractScheme.h"
+#include "TVDScheme.h"
+
+/**
+* Block-structured adaptive mesh refinement scheme class derived from the Abstract scheme
+* \nThe base grid is the uniform grid of the scheme, the finer levels are made of patches (blocks)
+* \nwhich cover only the steep gradients of the solution. Every level halves deltaX and deltaT,
+* \nso the fine levels are subcycled in time with the same Courant number. The patches are updated
+* \nusing the flux limited TVD fluxes and they follow the moving fronts by regridding.
+*
+* The AdaptiveMeshScheme class provides:
+* \n-calculateIteration function to advance the whole hierarchy with one coarse time step
+* \n-getCellUpdates function to retrieve the number of the cell updates of a run
+*/
+class AdaptiveMeshScheme : public AbstractScheme<>
+{
+	/**
+	* A block of nodes on one refinement level
+	* \nvalues[k] holds the node lo - ghosts + k in the index space of the level
+	*/
+	struct Patch
+	{
+		int level, lo, hi;
+		std::vector<double> values, previous;
+		std::vector<Patch> children;
+	};
+
+	/**
+	* The state of a run with the patch hierarchy
+	*/
+	class State : public SimulationState<>
+	{
+	public:
+		Patch root;
+		double gradientScale;
+		long long steps, cellUpdates;
+		std::vector<double> fluxes;
+		std::shared_ptr<const BatchFunction> initialFunction;
+	};
+
+	// The number of ghost nodes required by the limited fluxes on each side of a patch
+	static const int ghosts = 2;
+
+	FluxLimiter limiter;
+	int maxLevel, regridInterval;
+	double threshold;
+
+	static double& node(Patch& patch, int i);
+	static double sample(const Patch& parent, int fineIndex, double theta);
+
+	/**
+	* Private method that advances a patch and its children with one time step of the patch's level
+	* The children are subcycled with two half steps, then the fine solution is injected to the coarse nodes
+	*/
+	void advance(State& state, Patch& patch) const;
+
+	/**
+	* Private method that updates the owned nodes of a single patch
+	*/
+	void stepPatch(State& state, Patch& patch) const;
+
+	/**
+	* Private method that rebuilds the children of a patch from the gradient flags
+	* @param state State& - The state of the run
+	* @param patch Patch& - The patch to be refined
+	* @param old std::vector<std::vector<Patch>>& - The patches of the previous hierarchy by level
+	*/
+	void regrid(State& state, Patch& patch, std::vector<std::vector<Patch>>& old) const;
+
+	/**
+	* Private method that creates a child patch for the parent nodes clo ... chi
+	* The values are taken from the old patches of the same level where they overlap, otherwise from
+	* the initial function (first step, if it is known) or from the interpolated parent values
+	*/
+	void createChild(State& state, Patch& parent, int clo, int chi, std::vector<std::vector<Patch>>& old) const;
+
+protected:
+	/**
+	* The limited fluxes use the i-2 ... i+1 cells, the subcycled fine levels do not travel further
+	* @return int - The radius of the stencil in coarse cells
+	*/
+	int stencilRadius() const override;
+
+	/**
+	* Override the state allocation to provide the patch hierarchy
+	* @return std::unique_ptr<SimulationState<>> - The new state
+	*/
+	std::unique_ptr<SimulationState<>> allocateState() const override;
+
+	/**
+	* Override the preparation to reset the hierarchy and keep the initial function for the refined patches
+	* @param state SimulationState<>& - The state of the run
+	* @param initialFunction std::shared_ptr<const BatchFunction> - The initial function, nullptr if the initial values are given directly
+	*/
+	void prepare(SimulationState<>& state, std::shared_ptr<const BatchFunction> initialFunction) const override;
+
+	/**
+	* Override the report to write the number of the cell updates
+	* @param state const SimulationState<>& - The state of the run
+	* @param stream std::ostream& - The stream to write the results to
+	*/
+	void report(const SimulationState<>& state, std::ostream& stream) const override;
+
+public:
+	/**
+	* Constructor for the Adaptive Mesh scheme
+	* @param xStart double - Beginning of the space dimension
+	* @param xEnd double - End of the space dimension
+	* @param t double - The timeframe until the calculations should be executed
+	* @param spacePoints int - The number of intervals of the base grid
+	* @param u double - The velocity of the wave
+	* @param limiter FluxLimiter - The flux limiter used on every level
+	* @param maxLevel int - The number of refinement levels above the base grid
+	* @param threshold double - Nodes with a central difference above threshold * (max - min) are refined
+	* @param regridInterval int - The number of coarse steps between two regridding, the flagged nodes are buffered
+	* with the distance travelled until the next regridding plus the ghost nodes, measured in the nodes of every level
+	*/
+	AdaptiveMeshScheme(double xStart, double xEnd, double t, int spacePoints, double u, double cfl,
+		FluxLimiter limiter = FluxLimiter::VanLeer, int maxLevel = 2, double threshold = 0.05, int regridInterval = 4);
+
+	/**
+	* Override the pure virtual function to advance the hierarchy with one coarse time step
+	* It returns the composite solution on the base grid
+	* @param state SimulationState<>& - The state of the run
+	* @param double t - The current time frame
+	* @return const std::vector<double>& - The calculated numerical values
+	*/
+	const std::vector<double>& calculateIteration(SimulationState<>& state, double t) const override;
+
+	/**
+	* Public method that returns the number of the cell updates of all levels
+	* @param state const SimulationState<>& - The state of the run
+	* @return long long - The number of the cell updates of the run
+	*/
+	long long getCellUpdates(const SimulationState<>& state) const;
+
+	/**
+	* Public method that returns the number of the cell updates of a uniform grid with the finest resolution
+	* @param state const SimulationState<>& - The state of the run
+	* @return long long - The number of the cell updates of the equivalent uniform grid
+	*/
+	long long getUniformCellUpdates(const SimulationState<>& state) const;
+
+	/**
+	* Public method that checks the composite solution against the uniform grid with the finest resolution
+	* The uniform grid is advanced with the TVD scheme of the same limiter and time step from the initial function of the run,
+	* it costs more than the adaptive run, so only AdaptiveMeshBenchmark calls it
+	* Throws std::logic_error if the run was initialised with values instead of an initial function
+	* @param state const SimulationState<>& - The state of the run
+	* @return double - The maximum difference on the nodes of the base grid
+	*/
+	double uniformDifference(const SimulationState<>& state) const;
+
+	/**
+	* Override the identity with the refinement parameters
+	*/
+	std::string getIdentity() const override;
+
+	/**
+	* The patch hierarchy of the whole grid is kept between the time steps
+	* @return bool - False
+	*/
+	bool isLocal() const override;
+
+	/**
+	* Override the stencils with the ones of the limited scheme, every level is advanced with the same Courant number
+	*/
+	std::vector<Stencil> getStencils(double cfl) const override;
+};
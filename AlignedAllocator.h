@@ -0,0 +1,69 @@
+#pragma once // Include guard
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+/**
+* Allocator for the standard containers that aligns the storage to the given boundary
+* \nThe default 64 bytes alignment is the cache line size, which is also enough for every SIMD load
+* \nThe original pointer of the allocation is stored in front of the aligned block
+*/
+template <typename T, std::size_t Alignment = 64>
+class AlignedAllocator
+{
+public:
+	typedef T value_type;
+
+	template <typename U>
+	struct rebind
+	{
+		typedef AlignedAllocator<U, Alignment> other;
+	};
+
+	AlignedAllocator() = default;
+
+	template <typename U>
+	AlignedAllocator(const AlignedAllocator<U, Alignment>&)
+	{
+
+	}
+
+	/**
+	* Function that allocates aligned storage for the given number of elements
+	* @param count std::size_t - The number of the elements
+	* @return T* - The aligned storage
+	*/
+	T* allocate(std::size_t count)
+	{
+		auto raw = static_cast<char*>(::operator new(count * sizeof(T) + Alignment + sizeof(void*)));
+		auto address = reinterpret_cast<std::uintptr_t>(raw + sizeof(void*));
+		auto aligned = reinterpret_cast<void**>((address + Alignment - 1) & ~(std::uintptr_t)(Alignment - 1));
+
+		aligned[-1] = raw;
+
+		return reinterpret_cast<T*>(aligned);
+	}
+
+	/**
+	* Function that releases the storage allocated by the allocate function
+	* @param pointer T* - The aligned storage
+	* @param count std::size_t - The number of the elements (not used)
+	*/
+	void deallocate(T* pointer, std::size_t count)
+	{
+		::operator delete(reinterpret_cast<void**>(pointer)[-1]);
+	}
+};
+
+template <typename T, typename U, std::size_t Alignment>
+bool operator==(const AlignedAllocator<T, Alignment>&, const AlignedAllocator<U, Alignment>&)
+{
+	return true;
+}
+
+template <typename T, typename U, std::size_t Alignment>
+bool operator!=(const AlignedAllocator<T, Alignment>&, const AlignedAllocator<U, Alignment>&)
+{
+	return false;
+}
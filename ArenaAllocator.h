@@ -0,0 +1,91 @@
+#pragma once // Include guard
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include "MonotonicArena.h"
+
+/**
+* Allocator for the standard containers that takes the storage from a MonotonicArena
+* \nThe deallocation is a no-op, the storage is freed when the arena is released. Without an arena
+* \n(default constructed allocator) the storage is taken from the heap, so the containers work like with std::allocator.
+* \nThe allocator moves and swaps with the containers, the copies of a container stay in the arena of the source.
+*/
+template <typename T>
+class ArenaAllocator
+{
+	MonotonicArena* arena;
+
+	template <typename U>
+	friend class ArenaAllocator;
+
+public:
+	typedef T value_type;
+	typedef std::false_type propagate_on_container_copy_assignment;
+	typedef std::true_type propagate_on_container_move_assignment;
+	typedef std::true_type propagate_on_container_swap;
+
+	template <typename U>
+	struct rebind
+	{
+		typedef ArenaAllocator<U> other;
+	};
+
+	ArenaAllocator(MonotonicArena* _arena = nullptr) : arena(_arena)
+	{
+
+	}
+
+	template <typename U>
+	ArenaAllocator(const ArenaAllocator<U>& that) : arena(that.arena)
+	{
+
+	}
+
+	/**
+	* Function that allocates storage for the given number of elements
+	* @param count std::size_t - The number of the elements
+	* @return T* - The storage
+	*/
+	T* allocate(std::size_t count)
+	{
+		if (arena == nullptr) {
+			return static_cast<T*>(::operator new(count * sizeof(T)));
+		}
+
+		return static_cast<T*>(arena->allocate(count * sizeof(T)));
+	}
+
+	/**
+	* Function that releases the storage allocated by the allocate function, the arena storage is kept until the release of the arena
+	* @param pointer T* - The storage
+	* @param count std::size_t - The number of the elements (not used)
+	*/
+	void deallocate(T* pointer, std::size_t count)
+	{
+		if (arena == nullptr) {
+			::operator delete(pointer);
+		}
+	}
+
+	/**
+	* Function that returns the arena of the allocator
+	* @return MonotonicArena* - The arena, nullptr for the heap
+	*/
+	MonotonicArena* getArena() const
+	{
+		return arena;
+	}
+};
+
+template <typename T, typename U>
+bool operator==(const ArenaAllocator<T>& a, const ArenaAllocator<U>& b)
+{
+	return a.getArena() == b.getArena();
+}
+
+template <typename T, typename U>
+bool operator!=(const ArenaAllocator<T>& a, const ArenaAllocator<U>& b)
+{
+	return a.getArena() != b.getArena();
+}
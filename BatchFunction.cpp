@@ -0,0 +1,11 @@
+#include "BatchFunction.h"
+
+BatchFunction::~BatchFunction()
+{
+
+}
+
+std::string BatchFunction::getIdentity() const
+{
+	return "";
+}
@@ -0,0 +1,39 @@
+#pragma once // Include guard
+
+#include <cstddef>
+#include <string>
+
+/**
+* Abstract class representing a function of the space and time coordinates
+* \nThe function is evaluated for a whole span of grid points with one call,
+* \nso the implementations can use SIMD instructions instead of calling a scalar function per point
+*
+* The BatchFunction class provides:
+* \n-evaluate function, the interface for the exact functions
+* \n-getIdentity function to identify the function in the result cache
+*/
+class BatchFunction
+{
+public:
+	/**
+	* Virtual destructor to allow the deletion of derived classes through a pointer to the base class
+	*/
+	virtual ~BatchFunction();
+
+	/**
+	* Pure virtual function to evaluate the function at the given points
+	* The x and values arrays may be the same array
+	* @param x const double* - The space coordinates
+	* @param t double - The time frame (0 for the initial values)
+	* @param values double* - The calculated values
+	* @param count std::size_t - The number of the points
+	*/
+	virtual void evaluate(const double* x, double t, double* values, std::size_t count) const = 0;
+
+	/**
+	* Virtual function that returns the kind and the parameters of the function
+	* Two functions with the same identity must have the same values, the results of the unknown functions are not cached
+	* @return std::string - The identity of the function, empty if it is unknown (default implementation)
+	*/
+	virtual std::string getIdentity() const;
+};
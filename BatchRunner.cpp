@@ -0,0 +1,598 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include "BatchRunner.h"
+#include "JobFileException.h"
+#include "EnsembleEvaluator.h"
+#include "ExplicitUpwindScheme.h"
+#include "ImplicitUpwindScheme.h"
+#include "LaxWendroffScheme.h"
+#include "RichtmyerScheme.h"
+#include "TVDScheme.h"
+#include "WENOScheme.h"
+#include "SpectralScheme.h"
+#include "AdaptiveMeshScheme.h"
+#include "GaussianProfile.h"
+#include "StepProfile.h"
+#include "BoxProfile.h"
+#include "StreamingSolver.h"
+#include "SnapshotWriter.h"
+#include "ConvergenceStudy.h"
+#include "StabilityAnalysis.h"
+#include "SplitAdvectionSolver.h"
+
+static const char* schemeNames[] = { "explicit", "implicit", "implicit-mixed", "lax-wendroff", "richtmyer", "tvd-minmod", "tvd-vanleer", "tvd-superbee", "weno5", "spectral", "adaptive" };
+
+static const char* settingNames[] = { "schemes", "points", "time", "cfl", "initial", "amplitude", "pulse-start", "pulse-end", "left", "right",
+	"start", "end", "velocity", "output", "tracking", "checkpoints", "grid-values", "variations", "cache", "cache-size", "out-of-core", "chunk-size",
+	"snapshots", "snapshot-interval", "snapshot-tolerance", "study", "refinements", "study-tolerance", "dimensions", "layout", "thread-scaling" };
+
+// The limits of the integer settings, the points of the out-of-core mode can exceed the range of int
+static const double intLimit = std::numeric_limits<int>::max(), pointLimit = 1e15;
+
+BatchRunner::BatchRunner(std::ostream& _log)
+	: log(_log)
+{
+
+}
+
+BatchRunner::SettingReader::SettingReader(const JobFile::Entry& _entry)
+	: entry(_entry)
+{
+
+}
+
+void BatchRunner::SettingReader::fail(const std::string& message) const
+{
+	throw JobFileException("Job " + entry.name + ": " + message);
+}
+
+std::string BatchRunner::SettingReader::text(const std::string& key, const std::string& value) const
+{
+	auto setting = entry.settings.find(key);
+
+	return setting == entry.settings.end() ? value : setting->second;
+}
+
+std::vector<std::string> BatchRunner::SettingReader::list(const std::string& key) const
+{
+	return split(text(key, ""));
+}
+
+double BatchRunner::SettingReader::toNumber(const std::string& key, const std::string& value) const
+{
+	std::size_t length = 0;
+	double result = 0;
+
+	try {
+		result = std::stod(value, &length);
+	}
+	catch (const std::exception&) {
+		length = 0;
+	}
+
+	if (length == 0 || length != value.size()) {
+		fail("invalid number " + value + " for " + key + ".");
+	}
+
+	return result;
+}
+
+long long BatchRunner::SettingReader::toInteger(const std::string& key, const std::string& value, double limit) const
+{
+	auto result = toNumber(key, value);
+
+	if (result != std::floor(result) || std::fabs(result) > limit) {
+		fail("invalid integer " + value + " for " + key + ".");
+	}
+
+	return (long long)result;
+}
+
+double BatchRunner::SettingReader::number(const std::string& key, const std::string& value) const
+{
+	return toNumber(key, text(key, value));
+}
+
+long long BatchRunner::SettingReader::integer(const std::string& key, const std::string& value, double limit) const
+{
+	return toInteger(key, text(key, value), limit);
+}
+
+bool BatchRunner::SettingReader::flag(const std::string& key, const std::string& value) const
+{
+	auto setting = text(key, value);
+
+	if (setting != "true" && setting != "false") {
+		fail("invalid value " + setting + " for " + key + ", expected true or false.");
+	}
+
+	return setting == "true";
+}
+
+std::vector<std::string> BatchRunner::split(const std::string& list)
+{
+	std::vector<std::string> items;
+	std::size_t first = 0;
+
+	while (first <= list.size()) {
+		auto last = std::min(list.find(',', first), list.size());
+		auto item = list.substr(first, last - first);
+
+		item.erase(0, item.find_first_not_of(" \t"));
+		item.erase(item.find_last_not_of(" \t") + 1);
+
+		if (!item.empty()) {
+			items.push_back(item);
+		}
+
+		first = last + 1;
+	}
+
+	return items;
+}
+
+BatchRunner::OutOfCoreSettings BatchRunner::parseOutOfCore(const SettingReader& settings)
+{
+	OutOfCoreSettings outOfCore;
+
+	outOfCore.directory = settings.text("out-of-core", "");
+	outOfCore.chunkSize = (int)settings.integer("chunk-size", "1048576", 1 << 28);
+
+	if (!outOfCore.directory.empty() && outOfCore.chunkSize < 16) {
+		settings.fail("the chunk size must be at least 16 nodes.");
+	}
+
+	return outOfCore;
+}
+
+BatchRunner::SnapshotSettings BatchRunner::parseSnapshots(const SettingReader& settings)
+{
+	SnapshotSettings snapshots;
+
+	snapshots.directory = settings.text("snapshots", "");
+	snapshots.interval = (int)settings.integer("snapshot-interval", "1", intLimit);
+	snapshots.tolerance = settings.number("snapshot-tolerance", "0");
+
+	if (snapshots.interval <= 0 || snapshots.tolerance < 0) {
+		settings.fail("the snapshot interval must be positive and the snapshot tolerance must not be negative.");
+	}
+
+	return snapshots;
+}
+
+BatchRunner::StudySettings BatchRunner::parseStudy(const SettingReader& settings, const Job& job)
+{
+	StudySettings study;
+
+	study.enabled = settings.flag("study", "false");
+	study.refinements = (int)settings.integer("refinements", "4", 20);
+	study.tolerance = settings.number("study-tolerance", "1e-3");
+
+	if (!study.enabled) {
+		return study;
+	}
+
+	if (study.refinements < 1 || study.tolerance <= 0) {
+		settings.fail("the study needs at least one refinement and a positive tolerance.");
+	}
+
+	if (std::find(job.cfls.begin(), job.cfls.end(), 0.0) != job.cfls.end()) {
+		settings.fail("the study compares the schemes with a given cfl, auto is not available.");
+	}
+
+	if (std::any_of(job.points.begin(), job.points.end(), [&](long long points) { return (points << study.refinements) > intLimit; })) {
+		settings.fail("the finest grid of the study exceeds the range of int.");
+	}
+
+	return study;
+}
+
+BatchRunner::SplitSettings BatchRunner::parseSplit(const SettingReader& settings, const Job& job)
+{
+	SplitSettings split;
+	auto layout = settings.text("layout", "tiled");
+
+	split.dimensions = (int)settings.integer("dimensions", "1", 3);
+	split.scaling = settings.flag("thread-scaling", "false");
+
+	if (split.dimensions < 1) {
+		settings.fail("the dimensions must be 1, 2 or 3.");
+	}
+
+	if (layout != "row-major" && layout != "tiled" && layout != "morton") {
+		settings.fail("unknown layout " + layout + ", expected row-major, tiled or morton.");
+	}
+
+	split.layout = layout == "row-major" ? FieldLayout::RowMajor : layout == "morton" ? FieldLayout::Morton : FieldLayout::Tiled;
+
+	if (split.dimensions == 1) {
+		if (split.scaling) {
+			settings.fail("the thread scaling is measured with the 2D or 3D solver, the dimensions must be 2 or 3.");
+		}
+
+		return split;
+	}
+
+	if (std::any_of(job.schemes.begin(), job.schemes.end(), [](const std::string& scheme) { return scheme != "explicit" && scheme != "lax-wendroff" && scheme != "richtmyer"; })) {
+		settings.fail("only the explicit, lax-wendroff and richtmyer schemes have linear stencils, the other schemes cannot be split.");
+	}
+
+	// The field of the largest grid must fit in memory
+	if (std::any_of(job.points.begin(), job.points.end(), [&](long long points) { return std::pow((double)points + 1, split.dimensions) > (double)(1LL << 31); })) {
+		settings.fail("the field of the points exceeds 2^31 nodes.");
+	}
+
+	return split;
+}
+
+BatchRunner::VariationSettings BatchRunner::parseVariations(const SettingReader& settings)
+{
+	VariationSettings variations;
+
+	variations.enabled = settings.flag("variations", "false");
+	variations.cache = settings.text("cache", "");
+	variations.cacheSize = settings.number("cache-size", "256");
+
+	if (variations.cacheSize <= 0) {
+		settings.fail("the cache size must be positive.");
+	}
+
+	return variations;
+}
+
+void BatchRunner::checkModes(const SettingReader& settings, const Job& job)
+{
+	auto separateOutput = job.gridValues || job.variations.enabled || !job.snapshots.directory.empty() || job.study.enabled;
+
+	if (!job.outOfCore.directory.empty()) {
+		if (separateOutput) {
+			settings.fail("the grid values, the variations, the snapshots and the study are not available out-of-core.");
+		}
+
+		if (std::any_of(job.schemes.begin(), job.schemes.end(), [](const std::string& scheme) { return scheme.compare(0, 8, "implicit") == 0 || scheme == "adaptive" || scheme == "spectral"; })) {
+			settings.fail("the implicit, adaptive and spectral schemes are not local, they cannot be solved out-of-core.");
+		}
+	}
+
+	if (job.split.dimensions > 1 && (separateOutput || !job.outOfCore.directory.empty())) {
+		settings.fail("the grid values, the variations, the snapshots, the study and the out-of-core mode are only available in 1D.");
+	}
+}
+
+BatchRunner::Job BatchRunner::createJob(const JobFile::Entry& entry)
+{
+	SettingReader settings(entry);
+
+	for (auto& setting : entry.settings) {
+		if (std::find_if(std::begin(settingNames), std::end(settingNames), [&](const char* name) { return setting.first == name; }) == std::end(settingNames)) {
+			settings.fail("unknown setting " + setting.first + ".");
+		}
+	}
+
+	Job job;
+
+	job.name = entry.name;
+	job.schemes = settings.list("schemes");
+	job.initial = settings.text("initial", "step");
+	job.output = settings.text("output", "-");
+
+	// Out-of-core the number of the points can exceed the range of int
+	job.outOfCore = parseOutOfCore(settings);
+
+	for (auto& value : settings.list("points")) {
+		job.points.push_back(settings.toInteger("points", value, job.outOfCore.directory.empty() ? intLimit : pointLimit));
+	}
+
+	for (auto& value : settings.list("time")) {
+		job.times.push_back(settings.toNumber("time", value));
+	}
+
+	// The automatic Courant number is stored as 0, the given ones must be positive
+	for (auto& value : settings.list("cfl")) {
+		job.cfls.push_back(value == "auto" ? 0 : settings.toNumber("cfl", value));
+
+		if (value != "auto" && job.cfls.back() <= 0) {
+			settings.fail("points, time and cfl must be positive.");
+		}
+	}
+
+	job.start = settings.number("start", "-50");
+	job.end = settings.number("end", "50");
+	job.velocity = settings.number("velocity", "1.75");
+	job.amplitude = settings.number("amplitude", "0.5");
+	job.pulseStart = settings.number("pulse-start", "-5");
+	job.pulseEnd = settings.number("pulse-end", "5");
+	job.left = (int)settings.integer("left", "0", intLimit);
+	job.right = (int)settings.integer("right", job.initial == "step" ? "1" : "0", intLimit);
+	job.checkpoints = (int)settings.integer("checkpoints", "0", intLimit);
+	job.tracking = settings.flag("tracking", "true");
+	job.gridValues = settings.flag("grid-values", "false");
+
+	if (job.schemes.empty() || job.points.empty() || job.times.empty() || job.cfls.empty()) {
+		settings.fail("schemes, points, time and cfl must be given.");
+	}
+
+	for (auto& scheme : job.schemes) {
+		if (std::find_if(std::begin(schemeNames), std::end(schemeNames), [&](const char* name) { return scheme == name; }) == std::end(schemeNames)) {
+			settings.fail("unknown scheme " + scheme + ".");
+		}
+	}
+
+	if (job.initial != "step" && job.initial != "gaussian" && job.initial != "box") {
+		settings.fail("unknown initial function " + job.initial + ", expected step, gaussian or box.");
+	}
+
+	if (std::any_of(job.points.begin(), job.points.end(), [](long long points) { return points <= 0; }) ||
+		std::any_of(job.times.begin(), job.times.end(), [](double t) { return t <= 0; }) ||
+		std::any_of(job.cfls.begin(), job.cfls.end(), [](double cfl) { return cfl < 0; })) {
+		settings.fail("points, time and cfl must be positive.");
+	}
+
+	if (job.end <= job.start || job.velocity <= 0) {
+		settings.fail("the domain must not be empty and the velocity must be positive.");
+	}
+
+	job.snapshots = parseSnapshots(settings);
+	job.study = parseStudy(settings, job);
+	job.split = parseSplit(settings, job);
+	job.variations = parseVariations(settings);
+
+	checkModes(settings, job);
+
+	return job;
+}
+
+std::shared_ptr<const BatchFunction> BatchRunner::createFunction(const Job& job)
+{
+	if (job.initial == "gaussian") {
+		return std::make_shared<GaussianProfile>(job.amplitude, job.velocity);
+	}
+
+	if (job.initial == "box") {
+		return std::make_shared<BoxProfile>(job.pulseStart, job.pulseEnd, job.amplitude, job.velocity);
+	}
+
+	return std::make_shared<StepProfile>(job.velocity);
+}
+
+std::shared_ptr<AbstractScheme<>> BatchRunner::createScheme(const std::string& name, const Job& job, int points, double t, double cfl)
+{
+	if (name == "explicit") {
+		return std::make_shared<ExplicitUpwindScheme<>>(job.start, job.end, t, points, job.velocity, cfl);
+	}
+
+	if (name == "implicit" || name == "implicit-mixed") {
+		auto scheme = std::make_shared<ImplicitUpwindScheme<>>(job.start, job.end, t, points, job.velocity, cfl);
+		scheme->setMixedPrecision(name == "implicit-mixed");
+		return scheme;
+	}
+
+	if (name == "lax-wendroff") {
+		return std::make_shared<LaxWendroffScheme<>>(job.start, job.end, t, points, job.velocity, cfl);
+	}
+
+	if (name == "richtmyer") {
+		return std::make_shared<RichtmyerScheme<>>(job.start, job.end, t, points, job.velocity, cfl);
+	}
+
+	if (name == "weno5") {
+		return std::make_shared<WENOScheme<>>(job.start, job.end, t, points, job.velocity, cfl);
+	}
+
+	if (name == "spectral") {
+		return std::make_shared<SpectralScheme<>>(job.start, job.end, t, points, job.velocity, cfl);
+	}
+
+	if (name == "adaptive") {
+		return std::make_shared<AdaptiveMeshScheme>(job.start, job.end, t, points, job.velocity, cfl);
+	}
+
+	auto limiter = name == "tvd-minmod" ? FluxLimiter::Minmod : name == "tvd-superbee" ? FluxLimiter::Superbee : FluxLimiter::VanLeer;
+
+	return std::make_shared<TVDScheme<>>(job.start, job.end, t, points, job.velocity, cfl, limiter);
+}
+
+std::ostream& BatchRunner::sink(const std::string& output)
+{
+	if (output == "-") {
+		return std::cout;
+	}
+
+	auto& file = sinks[output];
+
+	if (!file) {
+		file.reset(new std::ofstream(output, std::ios_base::trunc));
+	}
+
+	if (!*file) {
+		throw std::runtime_error("The output " + output + " cannot be opened.");
+	}
+
+	return *file;
+}
+
+ResultCache* BatchRunner::cache(const Job& job)
+{
+	if (job.variations.cache.empty()) {
+		return nullptr;
+	}
+
+	// The version is calculated once, the caches are shared by the jobs
+	static const auto version = ResultCache::buildVersion();
+	auto& cache = caches[job.variations.cache];
+
+	if (!cache) {
+		cache.reset(new ResultCache(job.variations.cache, (std::uint64_t)(job.variations.cacheSize * (1 << 20)), version));
+	}
+
+	return cache.get();
+}
+
+void BatchRunner::execute(const Job& job)
+{
+	auto function = createFunction(job);
+	auto& stream = sink(job.output);
+
+	for (auto points : job.points) {
+		for (auto t : job.times) {
+			for (auto cfl : job.cfls) {
+				std::vector<std::shared_ptr<AbstractScheme<>>> schemes;
+
+				// Out-of-core the schemes only describe the method, their own grid is kept small
+				auto schemePoints = (int)(job.outOfCore.directory.empty() ? points : std::min(points, (long long)job.outOfCore.chunkSize));
+
+				for (auto& name : job.schemes) {
+					auto schemeCfl = cfl;
+
+					// Every scheme gets its own largest stable and accurate Courant number
+					if (cfl == 0) {
+						schemeCfl = StabilityAnalysis<>::autoCfl(*createScheme(name, job, schemePoints, t, 1));
+					}
+
+					schemes.push_back(createScheme(name, job, schemePoints, t, schemeCfl));
+					schemes.back()->setFunction(function, job.left, job.right);
+					schemes.back()->setActiveRegionTracking(job.tracking);
+				}
+
+				if (cfl == 0) {
+					stream << "\n" << job.name << ": points " << points << ", time " << t << ", cfl auto\n";
+
+					for (auto& scheme : schemes) {
+						stream << scheme->getName() << ": cfl " << scheme->getVelocity() * scheme->getDeltaT() / scheme->getGrid()->getDelta()
+							<< ", " << scheme->getTimeSteps() << " time steps\n";
+					}
+				}
+				else
+				{
+					stream << "\n" << job.name << ": points " << points << ", time " << t << ", cfl " << cfl << "\n";
+				}
+
+				if (job.split.dimensions > 1) {
+					for (auto& scheme : schemes) {
+						SplitAdvectionSolver<> solver(scheme, job.split.dimensions, job.split.layout);
+
+						if (job.split.scaling) {
+							solver.measureScaling(function, stream);
+						}
+						else
+						{
+							solver.solve(function, stream);
+						}
+					}
+				}
+				else if (!job.outOfCore.directory.empty()) {
+					auto& bandwidth = bandwidths[job.outOfCore.directory];
+
+					if (bandwidth <= 0) {
+						bandwidth = StreamingSolver<>::measureBandwidth(job.outOfCore.directory);
+					}
+
+					for (auto& scheme : schemes) {
+						StreamingSolver<>(scheme, points, job.outOfCore.directory, job.outOfCore.chunkSize, bandwidth).solve(function, stream, job.checkpoints);
+					}
+				}
+				else if (job.study.enabled) {
+					ConvergenceStudy::run(stream, schemes, function, t, cfl, (int)points, job.study.refinements, job.study.tolerance);
+				}
+				else if (job.gridValues) {
+					for (auto& scheme : schemes) {
+						auto state = scheme->createState();
+
+						stream << "\n" << scheme->getName() << "\n";
+						scheme->evaluate(*state, function, stream, true);
+					}
+				}
+				else if (schemes.size() > 1 && cfl != 0 && std::all_of(schemes.begin(), schemes.end(), [&](const std::shared_ptr<AbstractScheme<>>& scheme) {
+					return scheme->getDeltaT() == schemes[0]->getDeltaT() && scheme->isPeriodic() == schemes[0]->isPeriodic(); })) {
+					EnsembleEvaluator(schemes, stream).evaluate(function, job.left, job.right, job.checkpoints);
+				}
+				else
+				{
+					// The automatic Courant numbers and the time frame steps of the spectral scheme differ, so the schemes cannot be advanced in lock-step
+					for (auto& scheme : schemes) {
+						scheme->evaluate(function, stream);
+					}
+				}
+
+				if (!job.snapshots.directory.empty()) {
+					for (auto& scheme : schemes) {
+						auto state = scheme->createState();
+						auto path = job.snapshots.directory + "/" + job.name + " " + scheme->getName() + " " + std::to_string(points) + " " +
+							std::to_string(t) + " " + std::to_string(cfl) + ".snap";
+						SnapshotWriter writer(path, state->spacePoints + 1, job.snapshots.tolerance);
+
+						scheme->recordSnapshots(*state, function, writer, job.snapshots.interval);
+						writer.close();
+
+						stream << scheme->getName() << " snapshots: " << writer.getLevels() << " levels, " << writer.getRawBytes() << " bytes raw, "
+							<< writer.getCompressedBytes() << " bytes compressed (" << (double)writer.getRawBytes() / writer.getCompressedBytes() << "x)\n";
+					}
+				}
+
+				if (job.variations.enabled) {
+					auto functionName = job.initial == "gaussian" ? "exp" : job.initial == "step" ? "sgn" : job.initial;
+
+					for (auto& scheme : schemes) {
+						scheme->calculateAllVariations(functionName, function, cache(job));
+					}
+				}
+			}
+		}
+	}
+
+	stream.flush();
+}
+
+int BatchRunner::run(const std::string& path)
+{
+	typedef std::chrono::steady_clock clock;
+
+	std::vector<Job> jobs;
+
+	// Every job is validated before the first one is started
+	try {
+		for (auto& entry : JobFile::read(path)) {
+			jobs.push_back(createJob(entry));
+		}
+	}
+	catch (const std::exception& e) {
+		log << e.what() << std::endl;
+		return InvalidJobFile;
+	}
+
+	if (jobs.empty()) {
+		log << "The job file " << path << " does not contain any job." << std::endl;
+		return InvalidJobFile;
+	}
+
+	auto failed = 0;
+	auto batchStart = clock::now();
+
+	for (auto& job : jobs) {
+		auto start = clock::now();
+
+		try {
+			execute(job);
+
+			std::chrono::duration<double> elapsed = clock::now() - start;
+			log << job.name << ": done in " << elapsed.count() << "s" << std::endl;
+		}
+		catch (const std::exception& e) {
+			log << job.name << ": failed! " << e.what() << std::endl;
+			failed++;
+		}
+	}
+
+	std::chrono::duration<double> elapsed = clock::now() - batchStart;
+	log << jobs.size() - failed << " of " << jobs.size() << " jobs succeeded in " << elapsed.count() << "s" << std::endl;
+
+	for (auto& cache : caches) {
+		log << cache.first << ": ";
+		cache.second->writeStats(log);
+	}
+
+	return failed == 0 ? Success : JobFailed;
+}
@@ -0,0 +1,242 @@
+#pragma once // Include guard
+
+#include <fstream>
+#include <map>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "AbstractScheme.h"
+#include "BatchFunction.h"
+#include "Field.h"
+#include "JobFile.h"
+#include "ResultCache.h"
+
+/**
+* Non-interactive runner of the batch job files
+* \nAll jobs are validated before the first one is started, then they are executed back-to-back in one process,
+* \nso the thread pool and the grid cache are shared by the jobs. A failing job is reported and the next one is started.
+* \nThere are no prompts, the result is given by the exit code.
+*
+* The settings of a job (the lists are separated by commas, every combination of the points, times and CFLs is run):
+* \n-schemes: explicit, implicit, implicit-mixed, lax-wendroff, richtmyer, tvd-minmod, tvd-vanleer, tvd-superbee, weno5, spectral, adaptive,
+* \nthe spectral scheme has a periodic domain and takes the whole time frame in one step
+* \n-points, time, cfl: the number of the intervals, the time frames and the Courant numbers,
+* \nauto selects the largest stable and accurate Courant number of every scheme
+* \n-initial: step, gaussian or box (default value is step)
+* \n-amplitude, pulse-start, pulse-end: the height of the Gaussian or box pulse and the edges of the box (0.5, -5, 5)
+* \n-left, right: the boundary values (default values are given by the initial function)
+* \n-start, end, velocity: the domain and the velocity of the wave (-50, 50, 1.75)
+* \n-output: the file of the results, - is the standard output (default value is -)
+* \n-tracking: skip the quiescent cells (default value is true)
+* \n-checkpoints: the number of the time steps between two written time frames of the ensembles (0 writes the last time step only)
+* \n-grid-values: write the analytical and numerical values of every grid point (default value is false)
+* \n-variations: write the predefined grid and Courant number variations to the results directory (default value is false)
+* \n-cache, cache-size: the directory and the size cap in megabytes of the result cache of the variations (no cache, 256)
+* \n-out-of-core, chunk-size: the directory of the value files and the nodes per chunk of the out-of-core mode (in memory, 1048576),
+* \nthe local schemes are solved one by one, the points can exceed the range of int
+* \n-snapshots: the directory of the compressed time series of the grid values, one file per scheme (no snapshots)
+* \n-snapshot-interval, snapshot-tolerance: the time steps between two recorded levels and the maximum error of the lossy mode (1, 0 is lossless)
+* \n-study, refinements, study-tolerance: run the convergence study from the given points instead of the evaluation,
+* \nthe number of the halved space steps and the required L2 error (false, 4, 1e-3)
+* \n-dimensions, layout: solve the 2D or 3D advection with Strang splitting of the explicit, lax-wendroff and richtmyer schemes,
+* \nthe layout of the field is row-major, tiled or morton (1, tiled)
+* \n-thread-scaling: run the 2D or 3D solve with 1, 2, 4 ... threads up to the hardware threads and write the speedups (default value is false)
+*
+* The BatchRunner class provides:
+* \n-run function to validate and execute the jobs of a file
+*/
+class BatchRunner
+{
+public:
+	/**
+	* The exit codes of the batch mode
+	*/
+	enum ExitCode
+	{
+		Success = 0,
+		JobFailed = 1,
+		InvalidJobFile = 2
+	};
+
+private:
+	/**
+	* The settings of a job file entry, the conversions throw JobFileException with the name of the job
+	*/
+	class SettingReader
+	{
+		const JobFile::Entry& entry;
+
+	public:
+		SettingReader(const JobFile::Entry& entry);
+
+		/**
+		* Throws JobFileException with the message prefixed by the name of the job
+		*/
+		void fail(const std::string& message) const;
+
+		/**
+		* The value of a setting, the default value if it is not given
+		*/
+		std::string text(const std::string& key, const std::string& value) const;
+
+		/**
+		* The items of a comma separated list setting, empty if it is not given
+		*/
+		std::vector<std::string> list(const std::string& key) const;
+
+		/**
+		* Conversions of a value of the key, the number must be the whole value and the integers are limited to +-limit
+		*/
+		double toNumber(const std::string& key, const std::string& value) const;
+		long long toInteger(const std::string& key, const std::string& value, double limit) const;
+
+		/**
+		* Conversions of a setting, the default value is converted if it is not given
+		*/
+		double number(const std::string& key, const std::string& value) const;
+		long long integer(const std::string& key, const std::string& value, double limit) const;
+		bool flag(const std::string& key, const std::string& value) const;
+	};
+
+	/**
+	* The settings of the out-of-core mode: out-of-core, chunk-size (the directory is empty in memory)
+	*/
+	struct OutOfCoreSettings
+	{
+		std::string directory;
+		int chunkSize;
+	};
+
+	/**
+	* The settings of the snapshots: snapshots, snapshot-interval, snapshot-tolerance (the directory is empty without snapshots)
+	*/
+	struct SnapshotSettings
+	{
+		std::string directory;
+		int interval;
+		double tolerance;
+	};
+
+	/**
+	* The settings of the convergence study: study, refinements, study-tolerance
+	*/
+	struct StudySettings
+	{
+		bool enabled;
+		int refinements;
+		double tolerance;
+	};
+
+	/**
+	* The settings of the dimensional splitting: dimensions, layout, thread-scaling
+	*/
+	struct SplitSettings
+	{
+		int dimensions;
+		FieldLayout layout;
+		bool scaling;
+	};
+
+	/**
+	* The settings of the variations: variations, cache, cache-size (the directory is empty without a cache)
+	*/
+	struct VariationSettings
+	{
+		bool enabled;
+		std::string cache;
+		double cacheSize;
+	};
+
+	/**
+	* The validated settings of one job, the settings of the modes are kept in their own structs
+	*/
+	struct Job
+	{
+		std::string name, initial, output;
+		std::vector<std::string> schemes;
+		std::vector<long long> points;
+		std::vector<double> times, cfls;
+		double start, end, velocity, amplitude, pulseStart, pulseEnd;
+		int left, right, checkpoints;
+		bool tracking, gridValues;
+		OutOfCoreSettings outOfCore;
+		SnapshotSettings snapshots;
+		StudySettings study;
+		SplitSettings split;
+		VariationSettings variations;
+	};
+
+	std::ostream& log;
+	std::map<std::string, std::unique_ptr<std::ofstream>> sinks;
+	std::map<std::string, std::unique_ptr<ResultCache>> caches;
+	std::map<std::string, double> bandwidths;
+
+	/**
+	* Private method that converts the settings of a job file entry to a job
+	* The common settings are read first, then every mode reads and validates its own settings,
+	* \nat last the combinations of the modes are checked.
+	* Throws JobFileException for unknown settings and invalid values
+	*/
+	static Job createJob(const JobFile::Entry& entry);
+
+	/**
+	* Private methods that read the settings of a mode, the job contains the common settings
+	* Throws JobFileException for invalid values
+	*/
+	static OutOfCoreSettings parseOutOfCore(const SettingReader& settings);
+	static SnapshotSettings parseSnapshots(const SettingReader& settings);
+	static StudySettings parseStudy(const SettingReader& settings, const Job& job);
+	static SplitSettings parseSplit(const SettingReader& settings, const Job& job);
+	static VariationSettings parseVariations(const SettingReader& settings);
+
+	/**
+	* Private method that checks that the modes of a job can be combined
+	* Throws JobFileException for the combinations that are not available
+	*/
+	static void checkModes(const SettingReader& settings, const Job& job);
+
+	/**
+	* Private method that splits a comma separated list
+	*/
+	static std::vector<std::string> split(const std::string& list);
+
+	/**
+	* Private method that creates the initial and analytical function of a job
+	*/
+	static std::shared_ptr<const BatchFunction> createFunction(const Job& job);
+
+	/**
+	* Private method that creates a scheme by its name
+	*/
+	static std::shared_ptr<AbstractScheme<>> createScheme(const std::string& name, const Job& job, int points, double t, double cfl);
+
+	/**
+	* Private method that returns the stream of an output, the files are truncated when they are first used
+	*/
+	std::ostream& sink(const std::string& output);
+
+	/**
+	* Private method that returns the result cache of a directory, nullptr if the job does not use a cache
+	*/
+	ResultCache* cache(const Job& job);
+
+	/**
+	* Private method that executes every combination of the points, times and CFLs of a job
+	*/
+	void execute(const Job& job);
+
+public:
+	/**
+	* Constructor for the runner
+	* @param log std::ostream& - The stream of the progress and the error messages
+	*/
+	BatchRunner(std::ostream& log);
+
+	/**
+	* Function that validates and executes the jobs of a file
+	* @param path std::string - The path of the INI or JSON job file
+	* @return int - Success, JobFailed if any job failed, InvalidJobFile if the file cannot be read or a job is invalid
+	*/
+	int run(const std::string& path);
+};
@@ -0,0 +1,27 @@
+#include <sstream>
+#include "BoxProfile.h"
+
+BoxProfile::BoxProfile(double _start, double _end, double _height, double _velocity)
+	: start(_start), end(_end), height(_height), velocity(_velocity)
+{
+
+}
+
+void BoxProfile::evaluate(const double* x, double t, double* values, std::size_t count) const
+{
+	auto left = start + velocity * t, right = end + velocity * t;
+
+	for (std::size_t i = 0; i < count; i++) {
+		values[i] = height * ((x[i] > left) & (x[i] < right));
+	}
+}
+
+std::string BoxProfile::getIdentity() const
+{
+	std::ostringstream identity;
+
+	identity.precision(17);
+	identity << "box " << start << " " << end << " " << height << " " << velocity;
+
+	return identity.str();
+}
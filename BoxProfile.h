@@ -0,0 +1,33 @@
+#pragma once // Include guard
+
+#include "BatchFunction.h"
+
+/**
+* Batch function class of a moving square pulse (top hat)
+* \nf(x, t) = height if start < x - velocity * t < end, otherwise 0
+*/
+class BoxProfile : public BatchFunction
+{
+	double start, end, height, velocity;
+
+public:
+	/**
+	* Constructor for the square pulse
+	* @param start double - The left edge of the pulse at t = 0
+	* @param end double - The right edge of the pulse at t = 0
+	* @param height double - The height of the pulse
+	* @param velocity double - The velocity of the wave
+	*/
+	BoxProfile(double start, double end, double height, double velocity);
+
+	/**
+	* Override the pure virtual function to evaluate the pulse at the given points
+	* The loop is branch free, so it is vectorised by the compiler
+	*/
+	void evaluate(const double* x, double t, double* values, std::size_t count) const override;
+
+	/**
+	* Override the identity with the parameters of the pulse
+	*/
+	std::string getIdentity() const override;
+};
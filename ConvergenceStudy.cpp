@@ -0,0 +1,185 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include "ConvergenceStudy.h"
+#include "VectorNorms.h"
+
+// The short runs are repeated until this time is reached, so the coarse grids are timed reliably
+static const double minimumSeconds = 0.02;
+
+ConvergenceStudy::Run ConvergenceStudy::measure(const AbstractScheme<>& scheme, std::shared_ptr<const BatchFunction> function, int points, double t, double cfl)
+{
+	typedef std::chrono::steady_clock clock;
+
+	auto state = scheme.createState(points, t, cfl);
+	auto steps = std::max((int)std::ceil(t / state->deltaT - 1e-9), 1);
+
+	state->deltaT = t / steps;
+	state->timeSteps = steps;
+	state->cfl = scheme.getVelocity() * state->deltaT / state->deltaX;
+
+	std::chrono::duration<double> elapsed(0);
+	auto repetitions = 0;
+
+	do {
+		auto start = clock::now();
+
+		scheme.initialise(*state, function);
+
+		for (auto step = 1; step <= steps; step++) {
+			scheme.advance(*state, step);
+		}
+
+		elapsed += clock::now() - start;
+		repetitions++;
+	} while (elapsed.count() < minimumSeconds);
+
+	Run run;
+	run.points = points;
+	run.timeSteps = steps;
+	run.deltaX = state->deltaX;
+	run.deltaT = state->deltaT;
+	run.seconds = elapsed.count() / repetitions;
+	run.values.assign(state->currentValues.begin(), state->currentValues.end());
+
+	std::vector<double> difference(points + 1);
+
+	scheme.exactFunction(function)->evaluate(state->grid->coordinates(), t, difference.data(), difference.size());
+
+	for (auto i = 0; i <= points; i++) {
+		difference[i] = std::fabs(difference[i] - run.values[i]);
+	}
+
+	// The norms are scaled with the space step, so they approximate the integral norms and the grids are comparable
+	run.infinite = VectorNorms<double>::infiniteNorm(&difference);
+	run.first = VectorNorms<double>::pNorm(&difference, 1) * run.deltaX;
+	run.second = VectorNorms<double>::pNorm(&difference, 2) * std::sqrt(run.deltaX);
+
+	return run;
+}
+
+double ConvergenceStudy::fitOrder(const std::vector<Run>& runs, double Run::*norm)
+{
+	std::vector<double> x, y;
+
+	for (auto& run : runs) {
+		if (run.*norm > 0) {
+			x.push_back(std::log(run.deltaX));
+			y.push_back(std::log(run.*norm));
+		}
+	}
+
+	if (x.size() < 2) {
+		return 0;
+	}
+
+	auto count = (double)x.size();
+	auto meanX = 0.0, meanY = 0.0, covariance = 0.0, variance = 0.0;
+
+	for (std::size_t i = 0; i < x.size(); i++) {
+		meanX += x[i] / count;
+		meanY += y[i] / count;
+	}
+
+	for (std::size_t i = 0; i < x.size(); i++) {
+		covariance += (x[i] - meanX) * (y[i] - meanY);
+		variance += (x[i] - meanX) * (x[i] - meanX);
+	}
+
+	return covariance / variance;
+}
+
+void ConvergenceStudy::run(std::ostream& stream, const std::vector<std::shared_ptr<AbstractScheme<>>>& schemes, std::shared_ptr<const BatchFunction> function,
+	double t, double cfl, int points, int refinements, double tolerance)
+{
+	struct Candidate
+	{
+		std::string name;
+		Run finest;
+		double order;
+	};
+
+	std::vector<Candidate> candidates;
+	const Run* cheapest = nullptr;
+	std::string cheapestName;
+	std::vector<std::vector<Run>> studies(schemes.size());
+
+	stream << "\n-----------------------\nConvergence study\n-----------------------\n\n";
+	stream << "t = " << t << ", cfl = " << cfl << ", L2 tolerance = " << tolerance << "\n";
+
+	for (std::size_t s = 0; s < schemes.size(); s++) {
+		auto& runs = studies[s];
+		auto& scheme = *schemes[s];
+
+		for (auto level = 0; level <= refinements; level++) {
+			runs.push_back(measure(scheme, function, points << level, t, cfl));
+		}
+
+		auto order = fitOrder(runs, &Run::second);
+		auto factor = std::pow(2.0, order) - 1;
+
+		stream << "\n" << scheme.getName() << "\n";
+		stream << "points, delta x, delta t, seconds, Mcells/s, L1, L2, infinite, L2 order, Richardson estimate, extrapolated L2\n";
+
+		for (std::size_t level = 0; level < runs.size(); level++) {
+			auto& run = runs[level];
+			auto cellUpdates = (double)run.timeSteps * (run.points - 1);
+
+			stream << run.points << ", " << run.deltaX << ", " << run.deltaT << ", " << run.seconds << ", " << cellUpdates / run.seconds / 1e6 << ", "
+				<< run.first << ", " << run.second << ", " << run.infinite;
+
+			// The nodes of the coarser grid are the even nodes of the finer one, below order 0.5 the extrapolation is not reliable
+			if (level == 0 || run.second <= 0 || runs[level - 1].second <= 0 || order < 0.5) {
+				stream << ", -, -, -\n";
+			}
+			else
+			{
+				auto& coarse = runs[level - 1];
+				std::vector<double> correction(coarse.points + 1), error(coarse.points + 1), analytical(coarse.points + 1);
+
+				scheme.exactFunction(function)->evaluate(Grid::get(scheme.getGrid()->getStart(), scheme.getGrid()->getEnd(), coarse.points)->coordinates(), t, analytical.data(), analytical.size());
+
+				for (auto i = 0; i <= coarse.points; i++) {
+					correction[i] = std::fabs(run.values[2 * i] - coarse.values[i]) / factor;
+					error[i] = std::fabs(run.values[2 * i] + (run.values[2 * i] - coarse.values[i]) / factor - analytical[i]);
+				}
+
+				stream << ", " << std::log(coarse.second / run.second) / std::log(coarse.deltaX / run.deltaX) << ", "
+					<< VectorNorms<double>::pNorm(&correction, 2) * std::sqrt(coarse.deltaX) << ", "
+					<< VectorNorms<double>::pNorm(&error, 2) * std::sqrt(coarse.deltaX) << "\n";
+			}
+		}
+
+		stream << "fitted order: L1 " << fitOrder(runs, &Run::first) << ", L2 " << order << ", infinite " << fitOrder(runs, &Run::infinite) << "\n";
+
+		candidates.push_back(Candidate{ scheme.getName(), runs.back(), order });
+
+		for (auto& run : runs) {
+			if (run.second <= tolerance && (cheapest == nullptr || run.seconds < cheapest->seconds)) {
+				cheapest = &run;
+				cheapestName = scheme.getName();
+			}
+		}
+	}
+
+	stream << "\n";
+
+	if (cheapest != nullptr) {
+		stream << "The cheapest run below the tolerance is " << cheapestName << " with " << cheapest->points << " points, "
+			<< cheapest->seconds << "s, L2 " << cheapest->second << "\n";
+	}
+	else
+	{
+		stream << "No run is below the tolerance, the predicted number of intervals from the fitted orders:\n";
+
+		for (auto& candidate : candidates) {
+			if (candidate.order > 0) {
+				stream << candidate.name << ": " << (long long)std::ceil(candidate.finest.points * std::pow(candidate.finest.second / tolerance, 1 / candidate.order)) << "\n";
+			}
+			else
+			{
+				stream << candidate.name << ": the scheme does not converge\n";
+			}
+		}
+	}
+}
@@ -0,0 +1,73 @@
+#pragma once // Include guard
+
+#include <memory>
+#include <ostream>
+#include <vector>
+#include "AbstractScheme.h"
+#include "BatchFunction.h"
+
+/**
+* Static class for the work-precision and convergence order studies of the schemes
+* \nEvery scheme is run on a sequence of grids, every grid halves the space step of the previous one, and the Courant number
+* \nis kept, so the time step is halved as well. The wall-clock time and the grid scaled L1, L2 and infinite norms of the
+* \nerror are measured for every run and written as comma separated data (the points of the work-precision diagrams).
+* \nThe observed order is calculated between the successive grids and fitted to all of them with least squares.
+* \nThe Richardson extrapolation of the successive grids estimates the error of the finer solution without the analytical
+* \nsolution, and its extrapolated values show the accuracy gained by the combination of the two runs.
+*
+* The ConvergenceStudy class provides:
+* \n-run function to study the schemes and select the cheapest run that meets a tolerance
+*/
+class ConvergenceStudy
+{
+	/**
+	* The measured values of a single run
+	*/
+	struct Run
+	{
+		int points, timeSteps;
+		double deltaX, deltaT, seconds, first, second, infinite;
+		std::vector<double> values;
+	};
+
+	/**
+	* Private method that runs a scheme on a grid until t and measures the time and the errors
+	* The time step is shortened to reach t exactly, so the runs of the different grids end at the same time
+	* @param scheme const AbstractScheme<>& - The scheme to be measured
+	* @param function std::shared_ptr<const BatchFunction> - The initial and analytical function
+	* @param points int - The number of intervals in the space dimension
+	* @param t double - The timeframe until the calculations should be executed
+	* @param cfl double - The Courant number
+	* @return Run - The measured values
+	*/
+	static Run measure(const AbstractScheme<>& scheme, std::shared_ptr<const BatchFunction> function, int points, double t, double cfl);
+
+	/**
+	* Private method that returns the least squares slope of the logarithm of the errors against the logarithm of the space steps
+	* The zero errors are skipped, the slope is 0 if less than two errors remain
+	*/
+	static double fitOrder(const std::vector<Run>& runs, double Run::*norm);
+
+public:
+	// Delete default member functions to emphasize that the class should only be used to access the static functions.
+	ConvergenceStudy() = delete;
+	~ConvergenceStudy() = delete;
+	ConvergenceStudy(const ConvergenceStudy& that) = delete;
+	ConvergenceStudy & operator=(const ConvergenceStudy&) = delete;
+
+	/**
+	* Static public method that studies the schemes and writes the work-precision data, the orders and the cheapest run
+	* The cheapest run is the fastest one with an L2 error below the tolerance, if no run meets it,
+	* the number of intervals is predicted from the fitted order of every scheme
+	* @param stream std::ostream& - The stream to write the results to
+	* @param schemes const std::vector<std::shared_ptr<AbstractScheme<>>>& - The schemes to be studied
+	* @param function std::shared_ptr<const BatchFunction> - The initial and analytical function
+	* @param t double - The timeframe until the calculations should be executed
+	* @param cfl double - The Courant number
+	* @param points int - The number of intervals of the coarsest grid
+	* @param refinements int - The number of the refined grids
+	* @param tolerance double - The required L2 error
+	*/
+	static void run(std::ostream& stream, const std::vector<std::shared_ptr<AbstractScheme<>>>& schemes, std::shared_ptr<const BatchFunction> function,
+		double t, double cfl, int points, int refinements, double tolerance);
+};
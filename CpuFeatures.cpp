@@ -0,0 +1,174 @@
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include "CpuFeatures.h"
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define CPUFEATURES_X86
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+// The environment variable that forces an instruction set
+static const char* const overrideVariable = "ADVECTION_ISA";
+
+#ifdef CPUFEATURES_X86
+
+// The registers EAX, EBX, ECX and EDX of a CPUID leaf
+static void cpuid(unsigned int leaf, unsigned int subleaf, unsigned int registers[4])
+{
+#ifdef _MSC_VER
+	int values[4];
+
+	__cpuidex(values, (int)leaf, (int)subleaf);
+	std::copy(values, values + 4, registers);
+#else
+	__cpuid_count(leaf, subleaf, registers[0], registers[1], registers[2], registers[3]);
+#endif
+}
+
+// The register states saved by the operating system (XCR0)
+static unsigned long long savedStates()
+{
+#ifdef _MSC_VER
+	return _xgetbv(0);
+#else
+	unsigned int low, high;
+
+	__asm__ volatile("xgetbv" : "=a"(low), "=d"(high) : "c"(0));
+
+	return ((unsigned long long)high << 32) | low;
+#endif
+}
+
+#endif
+
+// The value of an environment variable, empty if it is not set
+static std::string environment(const char* variable)
+{
+#ifdef _MSC_VER
+	char* value = nullptr;
+	std::size_t length = 0;
+
+	if (_dupenv_s(&value, &length, variable) != 0 || value == nullptr) {
+		return "";
+	}
+
+	std::string text(value);
+	free(value);
+
+	return text;
+#else
+	auto value = std::getenv(variable);
+
+	return value ? value : "";
+#endif
+}
+
+InstructionSet CpuFeatures::detect()
+{
+#ifdef CPUFEATURES_X86
+	unsigned int registers[4];
+
+	cpuid(0, 0, registers);
+	auto maximumLeaf = registers[0];
+
+	// The wide registers are only usable if the operating system enabled XSAVE (OSXSAVE) and the processor has AVX
+	cpuid(1, 0, registers);
+
+	if (!(registers[2] & (1u << 27)) || !(registers[2] & (1u << 28)) || maximumLeaf < 7) {
+		return InstructionSet::SSE2;
+	}
+
+	auto states = savedStates();
+
+	cpuid(7, 0, registers);
+	auto features = registers[1];
+
+	// AVX2 needs the XMM and YMM states, AVX-512 the opmask and the ZMM states as well.
+	// The AVX-512 variant may be compiled with the F, CD, BW, DQ and VL subsets (MSVC /arch:AVX512), all of them are required
+	auto avx2 = (states & 0x6) == 0x6 && (features & (1u << 5));
+	const unsigned int avx512Subsets = (1u << 16) | (1u << 17) | (1u << 28) | (1u << 30) | (1u << 31);
+	auto avx512 = avx2 && (states & 0xe6) == 0xe6 && (features & avx512Subsets) == avx512Subsets;
+
+	if (avx512) {
+		return InstructionSet::AVX512;
+	}
+
+	if (avx2) {
+		return InstructionSet::AVX2;
+	}
+#endif
+
+	return InstructionSet::SSE2;
+}
+
+InstructionSet CpuFeatures::selected()
+{
+	// The selection runs once, the initialisation of the static local variable is thread safe
+	static const InstructionSet set = [] {
+		auto detected = detect();
+		auto forced = environment(overrideVariable);
+
+		if (forced.empty()) {
+			return detected;
+		}
+
+		try {
+			auto requested = parse(forced);
+
+			if (requested > detected) {
+				std::cerr << "Warning: the processor does not support " << name(requested) << ", the " << name(detected) << " kernels are used" << std::endl;
+
+				return detected;
+			}
+
+			return requested;
+		}
+		catch (const std::invalid_argument& exception) {
+			std::cerr << "Warning: " << exception.what() << ", the " << name(detected) << " kernels are used" << std::endl;
+
+			return detected;
+		}
+	}();
+
+	return set;
+}
+
+std::string CpuFeatures::name(InstructionSet set)
+{
+	switch (set) {
+	case InstructionSet::AVX512:
+		return "AVX-512";
+	case InstructionSet::AVX2:
+		return "AVX2";
+	default:
+		return "SSE2";
+	}
+}
+
+InstructionSet CpuFeatures::parse(const std::string& text)
+{
+	std::string lower(text);
+
+	std::transform(lower.begin(), lower.end(), lower.begin(), [](unsigned char c) { return (char)std::tolower(c); });
+
+	if (lower == "sse2") {
+		return InstructionSet::SSE2;
+	}
+
+	if (lower == "avx2") {
+		return InstructionSet::AVX2;
+	}
+
+	if (lower == "avx512") {
+		return InstructionSet::AVX512;
+	}
+
+	throw std::invalid_argument(std::string("unknown instruction set in ") + overrideVariable + ": " + text);
+}
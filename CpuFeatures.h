@@ -0,0 +1,66 @@
+#pragma once // Include guard
+
+#include <string>
+
+/**
+* The instruction set variants of the dispatched kernels, in the order of their width
+*/
+enum class InstructionSet
+{
+	SSE2,
+	AVX2,
+	AVX512
+};
+
+/**
+* Static class for the detection of the instruction sets of the processor
+* The features are queried once with CPUID, the wide registers are only used if the operating system saves them
+* \non the context switches (XGETBV). The targets other than x86 run the SSE2 variant, which is compiled there
+* \nfor the generic instruction set.
+*
+* The selected instruction set can be forced with the ADVECTION_ISA environment variable (sse2, avx2 or avx512)
+* \nto compare the variants on the same machine. The instruction sets that the processor does not support are
+* \nreplaced by the best supported one with a warning.
+*
+* The CpuFeatures class provides:
+* \n-detect function to query the widest instruction set supported by the processor
+* \n-selected function to retrieve the instruction set of the dispatched kernels
+* \n-name and parse functions to convert the instruction sets to and from text
+*/
+class CpuFeatures
+{
+public:
+	// Delete default member functions to emphasize that the class should only be used to access the static functions.
+	CpuFeatures() = delete;
+	~CpuFeatures() = delete;
+	CpuFeatures(const CpuFeatures& that) = delete;
+	CpuFeatures & operator=(const CpuFeatures&) = delete;
+
+	/**
+	* Static public method that returns the widest instruction set supported by the processor and the operating system
+	* @return InstructionSet - The detected instruction set
+	*/
+	static InstructionSet detect();
+
+	/**
+	* Static public method that returns the instruction set of the dispatched kernels
+	* It is selected on the first call from the detected one and the ADVECTION_ISA environment variable
+	* @return InstructionSet - The selected instruction set
+	*/
+	static InstructionSet selected();
+
+	/**
+	* Static public method that returns the name of an instruction set
+	* @param set InstructionSet - The instruction set
+	* @return std::string - The name (SSE2, AVX2 or AVX-512)
+	*/
+	static std::string name(InstructionSet set);
+
+	/**
+	* Static public method that converts the value of the environment variable to an instruction set
+	* Throws std::invalid_argument if the text is not sse2, avx2 or avx512 (the case is ignored)
+	* @param text const std::string& - The name of the instruction set
+	* @return InstructionSet - The instruction set
+	*/
+	static InstructionSet parse(const std::string& text);
+};
@@ -0,0 +1,107 @@
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include "EnsembleEvaluator.h"
+#include "UnstableSchemeException.h"
+
+EnsembleEvaluator::EnsembleEvaluator(std::vector<std::shared_ptr<AbstractScheme<>>> _schemes, std::ostream& _stream)
+	: schemes(_schemes), stream(_stream)
+{
+	if (schemes.empty()) {
+		throw std::invalid_argument("The ensemble must contain at least one scheme");
+	}
+
+	for (auto& scheme : schemes) {
+		if (scheme->getGrid() != schemes[0]->getGrid() || scheme->getTimeSteps() != schemes[0]->getTimeSteps() || scheme->getDeltaT() != schemes[0]->getDeltaT()) {
+			throw std::invalid_argument("The schemes of the ensemble must use the same grid and time steps");
+		}
+
+		if (scheme->isPeriodic() != schemes[0]->isPeriodic()) {
+			throw std::invalid_argument("The schemes of the ensemble must have the same boundaries");
+		}
+	}
+}
+
+std::vector<EnsembleEvaluator::Norms> EnsembleEvaluator::calculateNorms(const std::vector<double>& analytical, const std::vector<const std::vector<double>*>& values)
+{
+	std::vector<Norms> norms(values.size(), Norms{ 0.0, 0.0, 0.0 });
+
+	for (std::size_t i = 0; i < analytical.size(); i++) {
+		for (std::size_t s = 0; s < values.size(); s++) {
+			auto difference = std::fabs(analytical[i] - (*values[s])[i]);
+
+			norms[s].infinite = std::max(norms[s].infinite, difference);
+			norms[s].first += difference;
+			norms[s].second += difference * difference;
+		}
+	}
+
+	for (auto& norm : norms) {
+		norm.second = std::sqrt(norm.second);
+	}
+
+	return norms;
+}
+
+void EnsembleEvaluator::evaluate(std::shared_ptr<const BatchFunction> function, int left, int right, int checkpointInterval)
+{
+	auto grid = schemes[0]->getGrid();
+	auto timeSteps = schemes[0]->getTimeSteps();
+	auto deltaT = schemes[0]->getDeltaT();
+
+	auto exact = schemes[0]->exactFunction(function);
+	std::vector<double> analytical(grid->size());
+	std::vector<std::shared_ptr<AbstractScheme<>>> stable;
+	std::vector<std::unique_ptr<SimulationState<>>> states;
+	std::vector<std::string> unstable;
+
+	// The unstable schemes would diverge, they are reported and left out of the ensemble
+	for (auto& scheme : schemes) {
+		scheme->setFunction(function, left, right);
+		states.push_back(scheme->createState());
+
+		try {
+			scheme->initialise(*states.back(), function);
+			stable.push_back(scheme);
+		}
+		catch (const UnstableSchemeException& e) {
+			unstable.push_back(e.what());
+			states.pop_back();
+		}
+	}
+
+	std::vector<const std::vector<double>*> values(stable.size());
+
+	stream << "\n-----------------------\nEnsemble of " << schemes.size() << " schemes\n-----------------------\n\n";
+
+	for (auto& message : unstable) {
+		stream << message << std::endl << std::endl;
+	}
+
+	if (stable.empty()) {
+		return;
+	}
+
+	for (auto step = 1; step <= timeSteps; step++) {
+		for (std::size_t s = 0; s < stable.size(); s++) {
+			values[s] = &stable[s]->advance(*states[s], step);
+		}
+
+		if (step < timeSteps && (checkpointInterval <= 0 || step % checkpointInterval != 0)) {
+			continue;
+		}
+
+		// The analytical solution is shared by all schemes
+		exact->evaluate(grid->coordinates(), step * deltaT, analytical.data(), analytical.size());
+
+		auto norms = calculateNorms(analytical, values);
+
+		stream << "t = " << step * deltaT << std::endl;
+
+		for (std::size_t s = 0; s < stable.size(); s++) {
+			stream << stable[s]->getName() << ", infinite " << norms[s].infinite << ", 1st " << norms[s].first << ", 2nd " << norms[s].second << std::endl;
+		}
+
+		stream << std::endl;
+	}
+}
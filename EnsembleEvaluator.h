@@ -0,0 +1,59 @@
+#pragma once // Include guard
+
+#include <memory>
+#include <ostream>
+#include <vector>
+#include "AbstractScheme.h"
+
+/**
+* Evaluator advancing multiple schemes in lock-step over one shared grid and one initial condition
+* \nOnly the checkpoints are fused: the analytical solution is calculated once per checkpoint for all schemes,
+* \nand the error norms of all schemes are accumulated in one pass over the grid. The time steps are not fused,
+* \nevery scheme advances its own state with its own calculateIteration, so a time step is still one pass
+* \nover the memory per scheme.
+*
+* The EnsembleEvaluator class provides:
+* \n-evaluate function to run all schemes and write their errors to the stream
+*/
+class EnsembleEvaluator
+{
+	/**
+	* The error norms of one scheme at a checkpoint
+	*/
+	struct Norms
+	{
+		double infinite, first, second;
+	};
+
+	std::vector<std::shared_ptr<AbstractScheme<>>> schemes;
+	std::ostream& stream;
+
+	/**
+	* Private method that calculates the error norms of all schemes in one pass over the grid
+	* The grid point is the outer loop, so the analytical value is loaded once for all schemes
+	* @param analytical std::vector<double> - The analytical values on the whole grid
+	* @param values std::vector<const std::vector<double>*> - The numerical values of the schemes
+	* @return std::vector<Norms> - The error norms of the schemes
+	*/
+	static std::vector<Norms> calculateNorms(const std::vector<double>& analytical, const std::vector<const std::vector<double>*>& values);
+
+public:
+	/**
+	* Constructor for the ensemble, the schemes must use the same grid, time steps and boundaries (periodic or not)
+	* Throws std::invalid_argument otherwise
+	* @param schemes std::vector<std::shared_ptr<AbstractScheme<>>> - The schemes to be compared
+	* @param stream std::ostream& - The stream to write the results to
+	*/
+	EnsembleEvaluator(std::vector<std::shared_ptr<AbstractScheme<>>> schemes, std::ostream& stream);
+
+	/**
+	* Void function to evaluate all schemes for the given function and write the error norms
+	* The function is set as the analytical function of the schemes and its t = 0 values are the initial values
+	* The schemes that are unstable with the Courant number are reported without running them
+	* @param function std::shared_ptr<const BatchFunction> - The analytical function
+	* @param left int - The left boundary value
+	* @param right int - The right boundary value
+	* @param checkpointInterval int - The number of the time steps between two checkpoints (0 writes the last time step only)
+	*/
+	void evaluate(std::shared_ptr<const BatchFunction> function, int left, int right, int checkpointInterval = 0);
+};
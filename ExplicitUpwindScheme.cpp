@@ -1,25 +1,44 @@
+#include <algorithm>
 #include <iostream>
 #include "ExplicitUpwindScheme.h"
+#include "Kernels.h"
 
-ExplicitUpwindScheme::ExplicitUpwindScheme(double xStart, double xEnd, double t, int spacePoints, double u, double cfl, std::ostream& stream)
-	: AbstractScheme(stream, "Explicit Upwind Scheme", xStart, xEnd, t, spacePoints, u, cfl)
+template <typename T>
+ExplicitUpwindScheme<T>::ExplicitUpwindScheme(double xStart, double xEnd, double t, int spacePoints, double u, double cfl)
+	: AbstractScheme<T>("Explicit Upwind Scheme", xStart, xEnd, t, spacePoints, u, cfl)
 {
 
 }
 
-std::vector<double> ExplicitUpwindScheme::calculateIteration(double t)
+template <typename T>
+const std::vector<T>& ExplicitUpwindScheme<T>::calculateIteration(SimulationState<T>& state, double t) const
 {
-	std::vector<double> newValues;
+	auto& currentValues = state.currentValues;
+	auto& nextValues = state.nextValues;
+	auto spacePoints = state.spacePoints;
+	auto first = std::max(state.activeFirst, 1), last = std::min(state.activeLast, spacePoints - 1);
+	auto nu = static_cast<T>(this->u * (state.deltaT / state.deltaX));
 
-	newValues.push_back(left);
+	nextValues[0] = this->left;
 
-	for (auto i = 1; i < spacePoints; i++) {
-		newValues.push_back(currentValues[i] - u * (deltaT / deltaX) * (currentValues[i] - currentValues[i - 1]));
+	// The update has the conservative form, the upwind fluxes are the values multiplied by u
+	if (first <= last) {
+		Kernels::get<T>().conservativeUpdate(currentValues.data() + first, currentValues.data() + first, nextValues.data() + first, nu, last - first + 1);
 	}
 
-	newValues.push_back(right);
+	nextValues[spacePoints] = this->right;
 
-	currentValues = newValues;
+	currentValues.swap(nextValues);
 
 	return currentValues;
-}
\ No newline at end of file
+}
+
+template <typename T>
+std::vector<Stencil> ExplicitUpwindScheme<T>::getStencils(double cfl) const
+{
+	return { Stencil{ -1, { cfl, 1 - cfl }, {} } };
+}
+
+// Explicit instantiation for the supported value types
+template class ExplicitUpwindScheme<float>;
+template class ExplicitUpwindScheme<double>;
@@ -6,7 +6,8 @@
 * Explicit upwind scheme class derived from the Abstract scheme
 * It overrides the default implementation of the approximator function
 */
-class ExplicitUpwindScheme : public AbstractScheme
+template <typename T = double>
+class ExplicitUpwindScheme : public AbstractScheme<T>
 {
 public:
 	/**
@@ -16,16 +17,20 @@ public:
 	* @param t double - The timeframe until the calculations should be executed
 	* @param spacePoints int - The number of intervals in the space dimension
 	* @param u double - The velocity of the wave
-	* @param file std::ostream& - The stream to write the results to (default value is std::cout)
 	*/
-	ExplicitUpwindScheme(double xStart, double xEnd, double t, int spacePoints, double u, double cfl, std::ostream& stream);
+	ExplicitUpwindScheme(double xStart, double xEnd, double t, int spacePoints, double u, double cfl);
 	
 	/**
 	* Override the pure virtual function to approximate using the Explicit Upwind scheme
 	* It returns a vector of doubles containing the numerical values
+	* @param state SimulationState<T>& - The state of the run
 	* @param double t - The current time frame
-	* @return std::vector<double> - The calculated numerical values
+	* @return const std::vector<T>& - The calculated numerical values
 	*/
-	std::vector<double> calculateIteration(double t) override;
-};
+	const std::vector<T>& calculateIteration(SimulationState<T>& state, double t) const override;
 
+	/**
+	* Override the stencils with u(i)^(n+1) = cfl * u(i-1) + (1 - cfl) * u(i)
+	*/
+	std::vector<Stencil> getStencils(double cfl) const override;
+};
@@ -0,0 +1,234 @@
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include "FFTPlan.h"
+
+static const double pi = 3.14159265358979323846;
+
+template <typename T>
+FFTPlan<T>::FFTPlan(int _size)
+	: size(_size)
+{
+	if (size <= 0) {
+		throw std::invalid_argument("the size of the Fourier transform must be positive");
+	}
+
+	auto span = 1;
+
+	for (auto radix : factorise(size)) {
+		Stage stage;
+		stage.radix = radix;
+		stage.span = span;
+		stage.stride = size / (span * radix);
+
+		// The twiddle factors of the combined transforms of length span * radix
+		for (auto q = 1; q < radix; q++) {
+			for (auto j = 0; j < span; j++) {
+				auto angle = -2 * pi * j * q / (span * radix);
+
+				stage.twiddleReal.push_back(static_cast<T>(std::cos(angle)));
+				stage.twiddleImaginary.push_back(static_cast<T>(std::sin(angle)));
+			}
+		}
+
+		for (auto q = 0; q < radix; q++) {
+			stage.rootReal.push_back(static_cast<T>(std::cos(-2 * pi * q / radix)));
+			stage.rootImaginary.push_back(static_cast<T>(std::sin(-2 * pi * q / radix)));
+		}
+
+		stages.push_back(stage);
+		span *= radix;
+	}
+}
+
+template <typename T>
+std::shared_ptr<const FFTPlan<T>> FFTPlan<T>::get(int size)
+{
+	static std::mutex mutex;
+	static std::map<int, std::weak_ptr<const FFTPlan<T>>> plans;
+
+	std::lock_guard<std::mutex> lock(mutex);
+
+	auto found = plans.find(size);
+	auto plan = found != plans.end() ? found->second.lock() : nullptr;
+
+	if (!plan) {
+		// The expired entries are removed on every miss, like the ones of the grid cache
+		for (auto entry = plans.begin(); entry != plans.end();) {
+			if (entry->second.expired()) {
+				entry = plans.erase(entry);
+			}
+			else
+			{
+				++entry;
+			}
+		}
+
+		plan = std::make_shared<const FFTPlan<T>>(size);
+		plans[size] = plan;
+	}
+
+	return plan;
+}
+
+template <typename T>
+std::vector<int> FFTPlan<T>::factorise(int size)
+{
+	std::vector<int> radices;
+
+	// The radix 4 stages need the fewest operations, a single radix 2 stage takes the odd power of two
+	while (size % 4 == 0) {
+		radices.push_back(4);
+		size /= 4;
+	}
+
+	for (auto factor = 2; factor * factor <= size; factor++) {
+		while (size % factor == 0) {
+			radices.push_back(factor);
+			size /= factor;
+		}
+	}
+
+	if (size > 1) {
+		radices.push_back(size);
+	}
+
+	return radices;
+}
+
+template <typename T>
+void FFTPlan<T>::butterfly(const Stage& stage, const T* inReal, const T* inImaginary, T* outReal, T* outImaginary) const
+{
+	auto radix = stage.radix, span = stage.span, stride = stage.stride;
+	auto block = (std::size_t)stride, outBlock = (std::size_t)span * stride;
+	const T half = 0.5, sine60 = static_cast<T>(std::sqrt(0.75));
+
+	for (auto j = 0; j < span; j++) {
+		// The q-th input of the j-th transform starts at (j * radix + q) * stride, its output s at (j + s * span) * stride
+		auto xr = inReal + (std::size_t)j * radix * stride, xi = inImaginary + (std::size_t)j * radix * stride;
+		auto yr = outReal + (std::size_t)j * stride, yi = outImaginary + (std::size_t)j * stride;
+		auto wr = [&](int q) { return stage.twiddleReal[(q - 1) * span + j]; };
+		auto wi = [&](int q) { return stage.twiddleImaginary[(q - 1) * span + j]; };
+
+		if (radix == 2) {
+			auto w1r = wr(1), w1i = wi(1);
+
+			for (auto k = 0; k < stride; k++) {
+				auto c1r = xr[k + block] * w1r - xi[k + block] * w1i, c1i = xr[k + block] * w1i + xi[k + block] * w1r;
+
+				yr[k] = xr[k] + c1r;
+				yi[k] = xi[k] + c1i;
+				yr[k + outBlock] = xr[k] - c1r;
+				yi[k + outBlock] = xi[k] - c1i;
+			}
+		}
+		else if (radix == 3) {
+			auto w1r = wr(1), w1i = wi(1), w2r = wr(2), w2i = wi(2);
+
+			for (auto k = 0; k < stride; k++) {
+				auto c1r = xr[k + block] * w1r - xi[k + block] * w1i, c1i = xr[k + block] * w1i + xi[k + block] * w1r;
+				auto c2r = xr[k + 2 * block] * w2r - xi[k + 2 * block] * w2i, c2i = xr[k + 2 * block] * w2i + xi[k + 2 * block] * w2r;
+
+				// y1 and y2 are c0 - (c1 + c2) / 2 -+ i sin(60) (c1 - c2)
+				auto sr = c1r + c2r, si = c1i + c2i;
+				auto ur = xr[k] - half * sr, ui = xi[k] - half * si;
+				auto vr = sine60 * (c1i - c2i), vi = -sine60 * (c1r - c2r);
+
+				yr[k] = xr[k] + sr;
+				yi[k] = xi[k] + si;
+				yr[k + outBlock] = ur + vr;
+				yi[k + outBlock] = ui + vi;
+				yr[k + 2 * outBlock] = ur - vr;
+				yi[k + 2 * outBlock] = ui - vi;
+			}
+		}
+		else if (radix == 4) {
+			auto w1r = wr(1), w1i = wi(1), w2r = wr(2), w2i = wi(2), w3r = wr(3), w3i = wi(3);
+
+			for (auto k = 0; k < stride; k++) {
+				auto c1r = xr[k + block] * w1r - xi[k + block] * w1i, c1i = xr[k + block] * w1i + xi[k + block] * w1r;
+				auto c2r = xr[k + 2 * block] * w2r - xi[k + 2 * block] * w2i, c2i = xr[k + 2 * block] * w2i + xi[k + 2 * block] * w2r;
+				auto c3r = xr[k + 3 * block] * w3r - xi[k + 3 * block] * w3i, c3i = xr[k + 3 * block] * w3i + xi[k + 3 * block] * w3r;
+
+				// Two radix 2 levels, the odd outputs are rotated by -i
+				auto ar = xr[k] + c2r, ai = xi[k] + c2i, br = xr[k] - c2r, bi = xi[k] - c2i;
+				auto cr = c1r + c3r, ci = c1i + c3i, dr = c1r - c3r, di = c1i - c3i;
+
+				yr[k] = ar + cr;
+				yi[k] = ai + ci;
+				yr[k + outBlock] = br + di;
+				yi[k + outBlock] = bi - dr;
+				yr[k + 2 * outBlock] = ar - cr;
+				yi[k + 2 * outBlock] = ai - ci;
+				yr[k + 3 * outBlock] = br - di;
+				yi[k + 3 * outBlock] = bi + dr;
+			}
+		}
+		else
+		{
+			// Direct butterfly, every output is accumulated from the inputs with one combined complex factor
+			for (auto s = 0; s < radix; s++) {
+				auto outR = yr + s * outBlock, outI = yi + s * outBlock;
+
+				std::copy(xr, xr + stride, outR);
+				std::copy(xi, xi + stride, outI);
+
+				for (auto q = 1; q < radix; q++) {
+					auto rootR = stage.rootReal[s * q % radix], rootI = stage.rootImaginary[s * q % radix];
+					auto fr = wr(q) * rootR - wi(q) * rootI, fi = wr(q) * rootI + wi(q) * rootR;
+					auto inR = xr + q * block, inI = xi + q * block;
+
+					for (auto k = 0; k < stride; k++) {
+						outR[k] += inR[k] * fr - inI[k] * fi;
+						outI[k] += inR[k] * fi + inI[k] * fr;
+					}
+				}
+			}
+		}
+	}
+}
+
+template <typename T>
+void FFTPlan<T>::forward(T* real, T* imaginary, T* scratch) const
+{
+	T* sourceReal = real, *sourceImaginary = imaginary;
+	T* targetReal = scratch, *targetImaginary = scratch + size;
+
+	// The stages alternate between the arrays and the scratch
+	for (auto& stage : stages) {
+		butterfly(stage, sourceReal, sourceImaginary, targetReal, targetImaginary);
+		std::swap(sourceReal, targetReal);
+		std::swap(sourceImaginary, targetImaginary);
+	}
+
+	if (sourceReal != real) {
+		std::copy(sourceReal, sourceReal + size, real);
+		std::copy(sourceImaginary, sourceImaginary + size, imaginary);
+	}
+}
+
+template <typename T>
+void FFTPlan<T>::inverse(T* real, T* imaginary, T* scratch) const
+{
+	// Swapping the real and imaginary parts turns the forward transform into the inverse one
+	forward(imaginary, real, scratch);
+
+	auto scale = static_cast<T>(1.0 / size);
+
+	for (auto i = 0; i < size; i++) {
+		real[i] *= scale;
+		imaginary[i] *= scale;
+	}
+}
+
+template <typename T>
+int FFTPlan<T>::getSize() const
+{
+	return size;
+}
+
+// Explicit instantiation for the supported value types
+template class FFTPlan<float>;
+template class FFTPlan<double>;
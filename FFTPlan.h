@@ -0,0 +1,91 @@
+#pragma once // Include guard
+
+#include <memory>
+#include <vector>
+
+/**
+* Immutable plan of the complex discrete Fourier transform of a given size
+* \nThe transform is the self-sorting mixed-radix Stockham algorithm on split real and imaginary arrays:
+* \nthe size is factorised into radix 4, 2, 3 and the remaining prime stages, every stage reads one array
+* \nand writes the other, so no bit reversal is needed. The inner loops run over contiguous runs of the
+* \nsub-transforms with one twiddle factor per run, so they are vectorised. The prime radices above 3 use
+* \nthe direct O(p^2) butterfly, the sizes with large prime factors are slow.
+*
+* The plans are shared by reference counting, the get function returns the same plan for the same size
+* \nwhile anything still uses it. The plan is read-only, so it can be executed concurrently by many threads.
+*
+* The FFTPlan class provides:
+* \n-forward and inverse functions to transform an array in place
+* \n-factorise function to query the radices of the stages
+*
+* The values are stored with the T value type (float or double, default value is double),
+* \nthe twiddle factors are calculated in double precision.
+*/
+template <typename T = double>
+class FFTPlan
+{
+	/**
+	* A radix p stage of the transform, it combines p transforms of length span into transforms of length span * p
+	* \nThe twiddle factors w^(j * q) of the q-th input are stored from (q - 1) * span,
+	* \nthe roots are the powers of the p-th root of unity for the direct butterfly
+	*/
+	struct Stage
+	{
+		int radix, span, stride;
+		std::vector<T> twiddleReal, twiddleImaginary, rootReal, rootImaginary;
+	};
+
+	int size;
+	std::vector<Stage> stages;
+
+	/**
+	* Private method that executes a stage from the input arrays into the output arrays
+	*/
+	void butterfly(const Stage& stage, const T* inReal, const T* inImaginary, T* outReal, T* outImaginary) const;
+
+public:
+	/**
+	* Constructor that factorises the size and calculates the twiddle factors
+	* Throws std::invalid_argument if the size is not positive
+	* @param size int - The number of the complex values
+	*/
+	explicit FFTPlan(int size);
+
+	/**
+	* Static function that returns the shared plan of the given size
+	* A new plan is only created if no plan of the same size is alive, the function is thread safe
+	* \nThe cache only keeps the plans that are alive, the expired entries are removed when a plan is created
+	* @param size int - The number of the complex values
+	* @return std::shared_ptr<const FFTPlan<T>> - The shared plan
+	*/
+	static std::shared_ptr<const FFTPlan<T>> get(int size);
+
+	/**
+	* Static function that returns the radices of the stages of a size
+	* @param size int - The number of the complex values
+	* @return std::vector<int> - The radices in the order of the stages
+	*/
+	static std::vector<int> factorise(int size);
+
+	/**
+	* Function that calculates the forward transform X[s] = sum(x[j] * e^(-2 pi i j s / size)) in place
+	* @param real T* - The real parts
+	* @param imaginary T* - The imaginary parts
+	* @param scratch T* - The work array of 2 * size values
+	*/
+	void forward(T* real, T* imaginary, T* scratch) const;
+
+	/**
+	* Function that calculates the inverse transform in place, it is normalised, so it reverts the forward transform
+	* @param real T* - The real parts
+	* @param imaginary T* - The imaginary parts
+	* @param scratch T* - The work array of 2 * size values
+	*/
+	void inverse(T* real, T* imaginary, T* scratch) const;
+
+	/**
+	* Function that returns the size of the transform
+	* @return int - The number of the complex values
+	*/
+	int getSize() const;
+};
@@ -0,0 +1,116 @@
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <stdexcept>
+#include "Field.h"
+
+// The tile shape, the x lines are 64 nodes long (8 cache lines of doubles), the tiles are 64 x 8 x 8 nodes in 3D and 64 x 16 in 2D
+static const int tileLength = 64, tileHeight2D = 16, tileHeight3D = 8;
+
+// The Morton code of the tile coordinates, the bits of the coordinates are interleaved
+static std::uint64_t mortonCode(std::uint64_t x, std::uint64_t y, std::uint64_t z)
+{
+	std::uint64_t code = 0;
+
+	for (auto bit = 0; bit < 21; bit++) {
+		code |= ((x >> bit) & 1) << (3 * bit) | ((y >> bit) & 1) << (3 * bit + 1) | ((z >> bit) & 1) << (3 * bit + 2);
+	}
+
+	return code;
+}
+
+template <typename T>
+Field<T>::Field(int _nx, int _ny, int _nz, FieldLayout _layout)
+	: nx(_nx), ny(_ny), nz(_nz), layout(_layout)
+{
+	if (nx < 2 || ny < 2 || nz < 1) {
+		throw std::invalid_argument("the fields need at least two nodes in the x and y dimensions");
+	}
+
+	if (layout == FieldLayout::RowMajor) {
+		tileX = nx;
+		tileY = ny;
+		tileZ = nz;
+	}
+	else
+	{
+		tileX = std::min(nx, tileLength);
+		tileY = std::min(ny, nz > 1 ? tileHeight3D : tileHeight2D);
+		tileZ = std::min(nz, tileHeight3D);
+	}
+
+	tilesX = (nx + tileX - 1) / tileX;
+	tilesY = (ny + tileY - 1) / tileY;
+	tilesZ = (nz + tileZ - 1) / tileZ;
+
+	auto tiles = (std::size_t)tilesX * tilesY * tilesZ;
+	auto tileSize = (std::size_t)tileX * tileY * tileZ;
+	std::vector<std::size_t> order(tiles);
+
+	// The rank of a tile in the storage, row-major or along the Z-order curve
+	std::iota(order.begin(), order.end(), 0);
+
+	if (layout == FieldLayout::Morton) {
+		std::vector<std::uint64_t> codes(tiles);
+
+		for (std::size_t tile = 0; tile < tiles; tile++) {
+			codes[tile] = mortonCode(tile % tilesX, tile / tilesX % tilesY, tile / tilesX / tilesY);
+		}
+
+		std::sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) { return codes[a] < codes[b]; });
+	}
+
+	tileOffsets.resize(tiles);
+
+	for (std::size_t rank = 0; rank < tiles; rank++) {
+		tileOffsets[order[rank]] = rank * tileSize;
+	}
+
+	values.assign(tiles * tileSize, T(0));
+}
+
+template <typename T>
+int Field<T>::runLength(int i) const
+{
+	return std::min(tileX - i % tileX, nx - i);
+}
+
+template <typename T>
+int Field<T>::getNx() const
+{
+	return nx;
+}
+
+template <typename T>
+int Field<T>::getNy() const
+{
+	return ny;
+}
+
+template <typename T>
+int Field<T>::getNz() const
+{
+	return nz;
+}
+
+template <typename T>
+int Field<T>::getTileX() const
+{
+	return tileX;
+}
+
+template <typename T>
+FieldLayout Field<T>::getLayout() const
+{
+	return layout;
+}
+
+template <typename T>
+std::size_t Field<T>::size() const
+{
+	return (std::size_t)nx * ny * nz;
+}
+
+// Explicit instantiation for the supported value types
+template class Field<float>;
+template class Field<double>;
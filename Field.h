@@ -0,0 +1,91 @@
+#pragma once // Include guard
+
+#include <cstddef>
+#include <vector>
+#include "AlignedAllocator.h"
+
+/**
+* The memory layouts of the fields
+* \n-RowMajor: the x lines follow each other (one tile covering the whole field)
+* \n-Tiled: the field is stored in tiles with x lines of 64 nodes, the tiles are stored in row-major order
+* \n-Morton: the tiles are stored along the Z-order curve, so the neighbouring tiles are close in memory in every direction
+*/
+enum class FieldLayout { RowMajor, Tiled, Morton };
+
+/**
+* Node-centred values of a 2D or 3D grid (the 2D fields have one node in the z dimension)
+* \nThe x lines of the tiles are contiguous, so the sweeps along x read whole runs of values and the sweeps
+* \nalong y and z read the rows of the tiles as vectors. The storage is 64 bytes aligned and padded to whole tiles.
+*
+* The Field class provides:
+* \n-operator() to access the value of a node
+* \n-run function to access the contiguous x run of a tile starting at a node
+* \n-getNx, getNy, getNz, getTileX and getLayout functions to query the shape
+*
+* The values are stored with the T value type (float or double, default value is double)
+*/
+template <typename T = double>
+class Field
+{
+	int nx, ny, nz, tileX, tileY, tileZ, tilesX, tilesY, tilesZ;
+	FieldLayout layout;
+	std::vector<std::size_t> tileOffsets;
+	std::vector<T, AlignedAllocator<T>> values;
+
+	/**
+	* Private method that returns the storage index of a node
+	*/
+	std::size_t index(int i, int j, int k) const
+	{
+		auto tile = (std::size_t)(i / tileX) + tilesX * ((std::size_t)(j / tileY) + tilesY * (std::size_t)(k / tileZ));
+
+		return tileOffsets[tile] + ((std::size_t)(k % tileZ) * tileY + j % tileY) * tileX + i % tileX;
+	}
+
+public:
+	/**
+	* Constructor of a zero field
+	* Throws std::invalid_argument if a dimension has less than two nodes (the z dimension of the 2D fields has one)
+	* @param nx int - The number of the nodes in the x dimension
+	* @param ny int - The number of the nodes in the y dimension
+	* @param nz int - The number of the nodes in the z dimension (1 for 2D)
+	* @param layout FieldLayout - The memory layout (default value is Tiled)
+	*/
+	Field(int nx, int ny, int nz, FieldLayout layout = FieldLayout::Tiled);
+
+	/**
+	* Element access operators of the node (i, j, k)
+	*/
+	T& operator()(int i, int j, int k = 0) { return values[index(i, j, k)]; }
+	T operator()(int i, int j, int k = 0) const { return values[index(i, j, k)]; }
+
+	/**
+	* Public method that returns the contiguous values of the tile row starting at the node
+	* @param i int, j int, k int - The node
+	* @return T* - The first value, the run ends at the end of the tile or of the x dimension (see runLength)
+	*/
+	T* run(int i, int j, int k) { return &values[index(i, j, k)]; }
+	const T* run(int i, int j, int k) const { return &values[index(i, j, k)]; }
+
+	/**
+	* Public method that returns the number of the contiguous values from the node of the x index
+	* @param i int - The x index
+	* @return int - The length of the run
+	*/
+	int runLength(int i) const;
+
+	/**
+	* Public methods that return the shape of the field
+	*/
+	int getNx() const;
+	int getNy() const;
+	int getNz() const;
+	int getTileX() const;
+	FieldLayout getLayout() const;
+
+	/**
+	* Public method that returns the number of the nodes
+	* @return std::size_t - nx * ny * nz
+	*/
+	std::size_t size() const;
+};
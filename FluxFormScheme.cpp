@@ -0,0 +1,59 @@
+#include <algorithm>
+#include "FluxFormScheme.h"
+#include "Kernels.h"
+
+template <typename T>
+FluxFormScheme<T>::FluxFormScheme(std::string name, double xStart, double xEnd, double t, int spacePoints, double u, double cfl)
+	: AbstractScheme<T>(name, xStart, xEnd, t, spacePoints, u, cfl)
+{
+
+}
+
+template <typename T>
+int FluxFormScheme<T>::boundaryCells() const
+{
+	return this->stencilRadius();
+}
+
+template <typename T>
+std::unique_ptr<SimulationState<T>> FluxFormScheme<T>::allocateState() const
+{
+	return std::unique_ptr<SimulationState<T>>(new State());
+}
+
+template <typename T>
+const std::vector<T>& FluxFormScheme<T>::calculateIteration(SimulationState<T>& _state, double t) const
+{
+	auto& state = static_cast<State&>(_state);
+	auto& currentValues = state.currentValues;
+	auto& nextValues = state.nextValues;
+	auto& fluxes = state.fluxes;
+	auto spacePoints = state.spacePoints;
+	auto boundary = boundaryCells();
+	auto ratio = static_cast<T>(state.deltaT / state.deltaX);
+	auto first = std::max(state.activeFirst, boundary), last = std::min(state.activeLast, spacePoints - boundary);
+
+	fluxes.resize(spacePoints);
+
+	if (first <= last) {
+		calculateFluxes(state, first - 1, last);
+	}
+
+	for (auto i = 0; i < boundary; i++) {
+		nextValues[i] = this->left;
+		nextValues[spacePoints - i] = this->right;
+	}
+
+	// Conservative update, every flux is shared by the two neighbouring cells
+	if (first <= last) {
+		Kernels::get<T>().conservativeUpdate(currentValues.data() + first, fluxes.data() + first, nextValues.data() + first, ratio, last - first + 1);
+	}
+
+	currentValues.swap(nextValues);
+
+	return currentValues;
+}
+
+// Explicit instantiation for the supported value types
+template class FluxFormScheme<float>;
+template class FluxFormScheme<double>;
@@ -0,0 +1,73 @@
+#pragma once // Include guard
+
+#include "AbstractScheme.h"
+
+/**
+* Abstract flux-form (finite volume) scheme derived from the Abstract scheme
+* \nThe schemes derived from this class only have to provide the numerical flux
+* \nat the cell interfaces, every interface flux is calculated exactly once per time step
+*
+* The FluxFormScheme class provides:
+* \n-calculateIteration function, the conservative update of the cells from the interface fluxes
+* \n-calculateFluxes function, the interface for the exact flux functions
+* \n-boundaryCells function to specify the number of boundary cells kept at the boundary value
+*/
+template <typename T = double>
+class FluxFormScheme : public AbstractScheme<T>
+{
+protected:
+	/**
+	* The state of a run of the flux-form schemes
+	*/
+	class State : public SimulationState<T>
+	{
+	public:
+		/**
+		* The numerical fluxes at the cell interfaces
+		* \nfluxes[i] holds the flux between the cell i and i + 1
+		*/
+		std::vector<T> fluxes;
+	};
+
+	/**
+	* Override the state allocation to provide the flux buffer
+	* @return std::unique_ptr<SimulationState<T>> - The new state
+	*/
+	std::unique_ptr<SimulationState<T>> allocateState() const override;
+
+	/**
+	* Pure virtual function to calculate the numerical fluxes from the current values
+	* @param state State& - The state of the run, the fluxes are written to its flux buffer
+	* @param first int - The index of the first flux to be calculated (at least boundaryCells() - 1)
+	* @param last int - The index of the last flux to be calculated (at most spacePoints - boundaryCells())
+	*/
+	virtual void calculateFluxes(State& state, int first, int last) const = 0;
+
+	/**
+	* Virtual function that returns the number of cells kept at the boundary values on both sides
+	* @return int - The number of boundary cells (default value is the stencil radius)
+	*/
+	virtual int boundaryCells() const;
+
+public:
+	/**
+	* Constructor for the flux-form schemes
+	* @param name std::string - The name of the scheme
+	* @param xStart double - Beginning of the space dimension
+	* @param xEnd double - End of the space dimension
+	* @param t double - The timeframe until the calculations should be executed
+	* @param spacePoints int - The number of intervals in the space dimension
+	* @param u double - The velocity of the wave
+	* @param cfl double - The Courant number
+	*/
+	FluxFormScheme(std::string name, double xStart, double xEnd, double t, int spacePoints, double u, double cfl);
+
+	/**
+	* Override the pure virtual function to approximate using the conservative flux difference
+	* It returns a vector of doubles containing the numerical values
+	* @param state SimulationState<T>& - The state of the run
+	* @param double t - The current time frame
+	* @return const std::vector<T>& - The calculated numerical values
+	*/
+	const std::vector<T>& calculateIteration(SimulationState<T>& state, double t) const override;
+};
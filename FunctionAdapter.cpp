@@ -0,0 +1,20 @@
+#include "FunctionAdapter.h"
+
+FunctionAdapter::FunctionAdapter(std::function< double(double, double) > _function)
+	: function(_function)
+{
+
+}
+
+FunctionAdapter::FunctionAdapter(std::function< double(double) > _function)
+	: function([_function](double x, double t) { return _function(x); })
+{
+
+}
+
+void FunctionAdapter::evaluate(const double* x, double t, double* values, std::size_t count) const
+{
+	for (std::size_t i = 0; i < count; i++) {
+		values[i] = function(x[i], t);
+	}
+}
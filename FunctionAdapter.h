@@ -0,0 +1,31 @@
+#pragma once // Include guard
+
+#include <functional>
+#include "BatchFunction.h"
+
+/**
+* Batch function class that calls a per-point std::function for every grid point
+* \nIt keeps the lambda functions usable wherever a batch function is expected
+*/
+class FunctionAdapter : public BatchFunction
+{
+	std::function< double(double, double) > function;
+
+public:
+	/**
+	* Constructor for a function of the space and time coordinates
+	* @param function std::function< double(double, double) > - The function to be called
+	*/
+	explicit FunctionAdapter(std::function< double(double, double) > function);
+
+	/**
+	* Constructor for a function of the space coordinate only (initial values), the time frame is ignored
+	* @param function std::function< double(double) > - The function to be called
+	*/
+	explicit FunctionAdapter(std::function< double(double) > function);
+
+	/**
+	* Override the pure virtual function to call the adapted function for every point
+	*/
+	void evaluate(const double* x, double t, double* values, std::size_t count) const override;
+};
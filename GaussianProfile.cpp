@@ -0,0 +1,36 @@
+#include <sstream>
+#include "GaussianProfile.h"
+#include "SimdMath.h"
+
+GaussianProfile::GaussianProfile(double _amplitude, double _velocity)
+	: amplitude(_amplitude), velocity(_velocity)
+{
+
+}
+
+void GaussianProfile::evaluate(const double* x, double t, double* values, std::size_t count) const
+{
+	auto centre = velocity * t;
+
+	for (std::size_t i = 0; i < count; i++) {
+		auto distance = x[i] - centre;
+
+		values[i] = -distance * distance;
+	}
+
+	SimdMath::exp(values, values, count);
+
+	for (std::size_t i = 0; i < count; i++) {
+		values[i] *= amplitude;
+	}
+}
+
+std::string GaussianProfile::getIdentity() const
+{
+	std::ostringstream identity;
+
+	identity.precision(17);
+	identity << "gaussian " << amplitude << " " << velocity;
+
+	return identity.str();
+}
@@ -0,0 +1,30 @@
+#pragma once // Include guard
+
+#include "BatchFunction.h"
+
+/**
+* Batch function class of a moving Gaussian pulse
+* \nf(x, t) = amplitude * exp(-(x - velocity * t)^2), the exponentials are calculated with SIMD instructions
+*/
+class GaussianProfile : public BatchFunction
+{
+	double amplitude, velocity;
+
+public:
+	/**
+	* Constructor for the Gaussian pulse
+	* @param amplitude double - The height of the pulse
+	* @param velocity double - The velocity of the wave
+	*/
+	GaussianProfile(double amplitude, double velocity);
+
+	/**
+	* Override the pure virtual function to evaluate the pulse at the given points
+	*/
+	void evaluate(const double* x, double t, double* values, std::size_t count) const override;
+
+	/**
+	* Override the identity with the parameters of the pulse
+	*/
+	std::string getIdentity() const override;
+};
@@ -0,0 +1,80 @@
+#include <map>
+#include <mutex>
+#include <tuple>
+#include "Grid.h"
+
+Grid::Grid(double _start, double _end, int _intervals)
+	: start(_start), end(_end), delta((_end - _start) / _intervals), intervals(_intervals), points(_intervals + 1)
+{
+	for (auto i = 0; i < intervals; i++) {
+		points[i] = start + i * delta;
+	}
+
+	// The last point is exactly the end of the domain
+	points[intervals] = end;
+}
+
+std::shared_ptr<const Grid> Grid::get(double start, double end, int intervals)
+{
+	static std::mutex mutex;
+	static std::map<std::tuple<double, double, int>, std::weak_ptr<const Grid>> grids;
+
+	std::lock_guard<std::mutex> lock(mutex);
+
+	auto key = std::make_tuple(start, end, intervals);
+	auto found = grids.find(key);
+	auto grid = found != grids.end() ? found->second.lock() : nullptr;
+
+	if (!grid) {
+		// The expired entries are removed on every miss, so the sweeps over many sizes do not grow the map
+		for (auto entry = grids.begin(); entry != grids.end();) {
+			if (entry->second.expired()) {
+				entry = grids.erase(entry);
+			}
+			else
+			{
+				++entry;
+			}
+		}
+
+		grid = std::make_shared<const Grid>(start, end, intervals);
+		grids[key] = grid;
+	}
+
+	return grid;
+}
+
+const double* Grid::coordinates() const
+{
+	return points.data();
+}
+
+double Grid::operator[](int i) const
+{
+	return points[i];
+}
+
+int Grid::size() const
+{
+	return intervals + 1;
+}
+
+int Grid::getIntervals() const
+{
+	return intervals;
+}
+
+double Grid::getDelta() const
+{
+	return delta;
+}
+
+double Grid::getStart() const
+{
+	return start;
+}
+
+double Grid::getEnd() const
+{
+	return end;
+}
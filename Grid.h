@@ -0,0 +1,83 @@
+#pragma once // Include guard
+
+#include <memory>
+#include <vector>
+#include "AlignedAllocator.h"
+
+/**
+* Immutable class representing the node-centred grid of the space dimension
+* \nThe coordinates are calculated once from the integer indices (x_i = start + i * delta, i = 0 ... intervals),
+* \nso every grid has exactly intervals + 1 points without the drift of the accumulated coordinates
+*
+* The grids are shared by reference counting, the get function returns the same grid
+* \nfor the same parameters while any scheme still uses it
+*/
+class Grid
+{
+	double start, end, delta;
+	int intervals;
+	std::vector<double, AlignedAllocator<double>> points;
+
+public:
+	/**
+	* Constructor that calculates the coordinates of the grid
+	* @param start double - Beginning of the space dimension
+	* @param end double - End of the space dimension
+	* @param intervals int - The number of intervals in the space dimension
+	*/
+	Grid(double start, double end, int intervals);
+
+	/**
+	* Static function that returns the shared grid for the given parameters
+	* A new grid is only created if no grid with the same parameters is alive, the function is thread safe
+	* \nThe cache only keeps the grids that are alive, the expired entries are removed when a grid is created
+	* @param start double - Beginning of the space dimension
+	* @param end double - End of the space dimension
+	* @param intervals int - The number of intervals in the space dimension
+	* @return std::shared_ptr<const Grid> - The shared grid
+	*/
+	static std::shared_ptr<const Grid> get(double start, double end, int intervals);
+
+	/**
+	* Function that returns the coordinates of the grid points
+	* @return const double* - The 64 bytes aligned array of the intervals + 1 coordinates
+	*/
+	const double* coordinates() const;
+
+	/**
+	* Function that returns the coordinate of a grid point
+	* @param i int - The index of the grid point
+	* @return double - The coordinate of the grid point
+	*/
+	double operator[](int i) const;
+
+	/**
+	* Function that returns the number of the grid points
+	* @return int - The number of the grid points (intervals + 1)
+	*/
+	int size() const;
+
+	/**
+	* Function that returns the number of intervals in the space dimension
+	* @return int - The number of intervals
+	*/
+	int getIntervals() const;
+
+	/**
+	* Function that returns the distance of the neighbouring grid points
+	* @return double - The space step
+	*/
+	double getDelta() const;
+
+	/**
+	* Function that returns the beginning of the space dimension
+	* @return double - The first coordinate
+	*/
+	double getStart() const;
+
+	/**
+	* Function that returns the end of the space dimension
+	* @return double - The last coordinate
+	*/
+	double getEnd() const;
+};
@@ -1,47 +1,124 @@
+#include <algorithm>
+#include <cmath>
 #include <iostream>
+#include <limits>
 #include "ImplicitUpwindScheme.h"
 #include "LUFactorisation.h"
 
-ImplicitUpwindScheme::ImplicitUpwindScheme(double xStart, double xEnd, double t, int spacePoints, double u, double cfl, std::ostream& stream)
-	: AbstractScheme(stream, "Implicit Upwind Scheme", xStart, xEnd, t, spacePoints, u, cfl)
+template <typename T>
+ImplicitUpwindScheme<T>::ImplicitUpwindScheme(double xStart, double xEnd, double t, int spacePoints, double u, double cfl)
+	: AbstractScheme<T>("Implicit Upwind Scheme", xStart, xEnd, t, spacePoints, u, cfl), mixedPrecision(false)
 {
 
 }
 
 // Define the pure virtual function of the base class
-std::vector<double> ImplicitUpwindScheme::calculateIteration(double t)
+template <typename T>
+const std::vector<T>& ImplicitUpwindScheme<T>::calculateIteration(SimulationState<T>& _state, double t) const
 {
-	std::vector<double> newValues(spacePoints + 1);
+	auto& state = static_cast<State&>(_state);
+	auto spacePoints = state.spacePoints;
+	auto& newValues = state.nextValues;
 
-	LUFactorisation::luSolve(L, U, newValues, spacePoints + 1, currentValues);
+	if (mixedPrecision) {
+		solveMixedPrecision(state, newValues);
+	}
+	else {
+		LUFactorisation::luSolve(state.L, state.U, state.currentValues, spacePoints + 1, newValues);
+	}
+
+	newValues[0] = this->left;
+	newValues[spacePoints] = this->right;
+
+	state.currentValues.swap(newValues);
+
+	return state.currentValues;
+}
+
+template <typename T>
+void ImplicitUpwindScheme<T>::solveMixedPrecision(State& state, std::vector<T>& x) const
+{
+	auto n = state.spacePoints + 1;
+	auto& b = state.currentValues;
+	auto& A = state.A;
+	auto& lowB = state.lowB;
+	auto& lowX = state.lowX;
+
+	lowB.assign(b.begin(), b.end());
+	LUFactorisation::luSolve(state.lowL, state.lowU, lowB, n, lowX);
+	x.assign(lowX.begin(), lowX.end());
+
+	for (auto k = 0; k < refinementSteps; k++) {
+		// The residual expression is fused, every element is computed in the loop without a product vector
+		auto residualExpression = b - A * x;
+		auto residual = 0.0, scale = 0.0;
 
-	newValues[0] = left;
-	newValues[1] = newValues[1] + cfl;
-	newValues[spacePoints] = right;
+		// The residual is calculated in the precision of the state
+		for (auto i = 0; i < n; i++) {
+			auto r = residualExpression[i];
 
-	currentValues = newValues;
+			lowB[i] = static_cast<float>(r);
+			residual = std::max(residual, (double)std::fabs(r));
+			scale = std::max(scale, (double)std::fabs(b[i]));
+		}
+
+		if (residual <= std::numeric_limits<T>::epsilon() * scale) {
+			break;
+		}
+
+		LUFactorisation::luSolve(state.lowL, state.lowU, lowB, n, lowX);
+
+		for (auto i = 0; i < n; i++) {
+			x[i] += lowX[i];
+		}
+	}
+}
+
+template <typename T>
+int ImplicitUpwindScheme<T>::stencilRadius() const
+{
+	return std::numeric_limits<int>::max();
+}
 
-	return currentValues;
+template <typename T>
+std::unique_ptr<SimulationState<T>> ImplicitUpwindScheme<T>::allocateState() const
+{
+	return std::unique_ptr<SimulationState<T>>(new State());
 }
 
 // Define the pure virtual function of the base class
-void ImplicitUpwindScheme::createLUDecomposition()
+template <typename T>
+void ImplicitUpwindScheme<T>::createLUDecomposition(State& state) const
 {
-	L = Matrix(spacePoints + 1, spacePoints + 1);
-	U = Matrix(spacePoints + 1, spacePoints + 1);
-	Matrix A = Matrix(spacePoints + 1, spacePoints + 1);
+	auto spacePoints = state.spacePoints;
+	auto& A = state.A;
+	auto& L = state.L;
+	auto& U = state.U;
+
+	// The matrices of a previous run on the state are dropped before their arena is released
+	A = Matrix<T>();
+	L = Matrix<T>();
+	U = Matrix<T>();
+	state.lowL = Matrix<float>();
+	state.lowU = Matrix<float>();
+	state.arena.release();
+
+	L = Matrix<T>(spacePoints + 1, spacePoints + 1, &state.arena);
+	U = Matrix<T>(spacePoints + 1, spacePoints + 1, &state.arena);
+	A = Matrix<T>(spacePoints + 1, spacePoints + 1, &state.arena);
 	
-	auto cfl = (deltaT * u) / deltaX;
+	auto cfl = (state.deltaT * this->u) / state.deltaX;
 
 	for (auto i = 0; i <= spacePoints; i++) {
 		for (auto j = 0; j <= spacePoints; j++) {
+			// The first and last rows keep the boundary values
 			if (i == j) {
-				A[i][j] = 1 + cfl;
+				A[i][j] = (i == 0 || i == spacePoints) ? 1 : 1 + cfl;
 			}
 			/*else if (i + 1 == j) {
 				A[i][j] = 0.5 * cfl;
 			}*/
-			else if (i - 1 == j) {
+			else if (i - 1 == j && i != spacePoints) {
 				A[i][j] = - cfl;
 			}
 			else {
@@ -50,11 +127,48 @@ void ImplicitUpwindScheme::createLUDecomposition()
 		}
 	}
 
-	LUFactorisation::luFact(A, L, U, spacePoints + 1);
+	if (mixedPrecision) {
+		state.lowL = Matrix<float>(spacePoints + 1, spacePoints + 1, &state.arena);
+		state.lowU = Matrix<float>(spacePoints + 1, spacePoints + 1, &state.arena);
+		state.lowB.resize(spacePoints + 1);
+		state.lowX.resize(spacePoints + 1);
+		LUFactorisation::luFact(Matrix<float>(A), state.lowL, state.lowU, spacePoints + 1);
+	}
+	else {
+		LUFactorisation::luFact(A, L, U, spacePoints + 1);
+	}
+}
+
+template <typename T>
+void ImplicitUpwindScheme<T>::prepare(SimulationState<T>& state, std::shared_ptr<const BatchFunction> initialFunction) const
+{
+	createLUDecomposition(static_cast<State&>(state));
+}
+
+template <typename T>
+void ImplicitUpwindScheme<T>::setMixedPrecision(bool enabled)
+{
+	mixedPrecision = enabled;
+}
+
+template <typename T>
+std::string ImplicitUpwindScheme<T>::getIdentity() const
+{
+	return AbstractScheme<T>::getIdentity() + (mixedPrecision ? ", mixed precision" : "");
+}
+
+template <typename T>
+bool ImplicitUpwindScheme<T>::isLocal() const
+{
+	return false;
 }
 
-void ImplicitUpwindScheme::evaluate(std::function< double(double) > boundaryFunction, std::ostream *stream)
+template <typename T>
+std::vector<Stencil> ImplicitUpwindScheme<T>::getStencils(double cfl) const
 {
-	createLUDecomposition();
-	AbstractScheme::evaluate(boundaryFunction, stream);
-}
\ No newline at end of file
+	return { Stencil{ -1, { 0, 1 }, { -cfl, 1 + cfl } } };
+}
+
+// Explicit instantiation for the supported value types
+template class ImplicitUpwindScheme<float>;
+template class ImplicitUpwindScheme<double>;
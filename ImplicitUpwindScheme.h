@@ -6,12 +6,61 @@
 /**
 * Implicit upwind scheme class derived from the Abstract scheme
 * It overrides the default implementation of the approximator function
+*
+* In mixed precision mode the LU decomposition is calculated and stored in single precision,
+* \nthe solution is corrected with iterative refinement using the residual in the precision of the state
 */
-class ImplicitUpwindScheme : public AbstractScheme
+template <typename T = double>
+class ImplicitUpwindScheme : public AbstractScheme<T>
 {
-	Matrix L, U;
+	/**
+	* The state of a run of the implicit scheme with the matrix and its LU decomposition
+	*/
+	class State : public SimulationState<T>
+	{
+	public:
+		Matrix<T> A, L, U;
+		Matrix<float> lowL, lowU;
+
+		// The single precision right-hand side and correction of the iterative refinement
+		std::vector<float> lowB, lowX;
+	};
+
+	bool mixedPrecision;
+
+	// The maximum number of the iterative refinement steps in mixed precision mode
+	static const int refinementSteps = 3;
+
+	void createLUDecomposition(State& state) const;
+
+	/**
+	* Private method that solves A x = currentValues with the single precision factors and iterative refinement
+	* @param state State& - The state of the run
+	* @param x std::vector<T>& - The result vector
+	*/
+	void solveMixedPrecision(State& state, std::vector<T>& x) const;
+
+protected:
+	/**
+	* Every new value depends on all of the previous values through the implicit solve,
+	* so the active region always covers the whole grid
+	* @return int - The radius of the stencil (unbounded)
+	*/
+	int stencilRadius() const override;
+
+	/**
+	* Override the state allocation to provide the matrices
+	* @return std::unique_ptr<SimulationState<T>> - The new state
+	*/
+	std::unique_ptr<SimulationState<T>> allocateState() const override;
+
+	/**
+	* Override the preparation to create the LU decomposition for the time step of the state
+	* @param state SimulationState<T>& - The state of the run
+	* @param initialFunction std::shared_ptr<const BatchFunction> - The initial function (not used)
+	*/
+	void prepare(SimulationState<T>& state, std::shared_ptr<const BatchFunction> initialFunction) const override;
 
-	void createLUDecomposition();
 public:
 	/**
 	* Constructor for the Implicit Upwind scheme
@@ -20,22 +69,37 @@ public:
 	* @param t double - The timeframe until the calculations should be executed
 	* @param spacePoints int - The number of intervals in the space dimension
 	* @param u double - The velocity of the wave
-	* @param file std::ostream& - The stream to write the results to (default value is std::cout)
 	*/
-	ImplicitUpwindScheme(double xStart, double xEnd, double t, int spacePoints, double u, double cfl, std::ostream& stream);
+	ImplicitUpwindScheme(double xStart, double xEnd, double t, int spacePoints, double u, double cfl);
 	
 	/**
 	* Override the pure virtual function to approximate using the Implicit Upwind scheme
 	* It returns a vector of doubles containing the numerical values
+	* @param state SimulationState<T>& - The state of the run
 	* @param double t - The current time frame
-	* @return std::vector<double> - The calculated numerical values
+	* @return const std::vector<T>& - The calculated numerical values
 	*/
-	std::vector<double> calculateIteration(double t) override;
+	const std::vector<T>& calculateIteration(SimulationState<T>& state, double t) const override;
 
 	/**
-	* Virtual void function to approximate the current values at the given time frame
-	* @param boundaryFunction std::function< double(double) > - The boundary function to start the calculations
+	* Void function to enable or disable the mixed precision solve
+	* @param enabled bool - True to factorise in single precision and refine the solution
 	*/
-	void evaluate(std::function< double(double) > boundaryFunction, std::ostream *stream = nullptr) override;
-};
+	void setMixedPrecision(bool enabled);
+
+	/**
+	* Override the identity with the precision of the solver
+	*/
+	std::string getIdentity() const override;
+
+	/**
+	* The implicit solve couples every value of the grid
+	* @return bool - False
+	*/
+	bool isLocal() const override;
 
+	/**
+	* Override the stencils with (1 + cfl) * u(i)^(n+1) - cfl * u(i-1)^(n+1) = u(i)^n
+	*/
+	std::vector<Stencil> getStencils(double cfl) const override;
+};
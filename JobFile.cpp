@@ -0,0 +1,330 @@
+#include "JobFile.h"
+#include "JobFileException.h"
+
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <iterator>
+
+std::vector<JobFile::Entry> JobFile::read(const std::string& path)
+{
+	std::ifstream file(path);
+
+	if (!file) {
+		throw JobFileException("The file " + path + " cannot be opened.");
+	}
+
+	auto json = path.size() >= 5 && path.compare(path.size() - 5, 5, ".json") == 0;
+
+	// Without the extension the first characters decide, the INI sections also start with [
+	if (!json) {
+		std::string text((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+		std::size_t position = 0;
+
+		skipWhitespace(text, position);
+
+		if (position < text.size() && text[position] == '[') {
+			position++;
+			skipWhitespace(text, position);
+			json = position < text.size() && (text[position] == '{' || text[position] == ']');
+		}
+		else
+		{
+			json = position < text.size() && text[position] == '{';
+		}
+
+		file.clear();
+		file.seekg(0);
+	}
+
+	return json ? parseJson(file) : parseIni(file);
+}
+
+void JobFile::applyDefaults(std::vector<Entry>& entries, const std::map<std::string, std::string>& defaults)
+{
+	for (auto& entry : entries) {
+		// insert does not overwrite the settings of the job
+		entry.settings.insert(defaults.begin(), defaults.end());
+	}
+}
+
+std::string JobFile::trim(const std::string& text)
+{
+	auto first = text.find_first_not_of(" \t\r\n");
+
+	if (first == std::string::npos) {
+		return "";
+	}
+
+	return text.substr(first, text.find_last_not_of(" \t\r\n") - first + 1);
+}
+
+std::vector<JobFile::Entry> JobFile::parseIni(std::istream& stream)
+{
+	std::vector<Entry> entries;
+	std::map<std::string, std::string> defaults;
+	std::map<std::string, std::string>* section = nullptr;
+	std::string line;
+
+	for (auto number = 1; std::getline(stream, line); number++) {
+		line = trim(line);
+
+		// Empty lines and comments
+		if (line.empty() || line[0] == ';' || line[0] == '#') {
+			continue;
+		}
+
+		if (line[0] == '[') {
+			if (line.back() != ']') {
+				throw JobFileException("Missing ] in line " + std::to_string(number) + ".");
+			}
+
+			auto name = trim(line.substr(1, line.size() - 2));
+
+			if (name == "defaults") {
+				section = &defaults;
+			}
+			else
+			{
+				entries.push_back(Entry{ name, {} });
+				section = &entries.back().settings;
+			}
+
+			continue;
+		}
+
+		auto separator = line.find('=');
+
+		if (separator == std::string::npos || section == nullptr) {
+			throw JobFileException("Expected a key = value setting of a section in line " + std::to_string(number) + ".");
+		}
+
+		(*section)[trim(line.substr(0, separator))] = trim(line.substr(separator + 1));
+	}
+
+	applyDefaults(entries, defaults);
+
+	return entries;
+}
+
+void JobFile::skipWhitespace(const std::string& text, std::size_t& position)
+{
+	while (position < text.size() && std::isspace((unsigned char)text[position])) {
+		position++;
+	}
+}
+
+void JobFile::expect(const std::string& text, std::size_t& position, char character)
+{
+	skipWhitespace(text, position);
+
+	if (position >= text.size() || text[position] != character) {
+		throw JobFileException(std::string("Expected ") + character + " at character " + std::to_string(position) + ".");
+	}
+
+	position++;
+}
+
+std::string JobFile::parseString(const std::string& text, std::size_t& position)
+{
+	std::string result;
+
+	expect(text, position, '"');
+
+	while (position < text.size() && text[position] != '"') {
+		auto character = text[position++];
+
+		if (character != '\\') {
+			result += character;
+			continue;
+		}
+
+		if (position >= text.size()) {
+			break;
+		}
+
+		switch (character = text[position++]) {
+		case 'n': result += '\n'; break;
+		case 't': result += '\t'; break;
+		case 'r': result += '\r'; break;
+		case 'b': result += '\b'; break;
+		case 'f': result += '\f'; break;
+		case 'u':
+		{
+			// The escape needs exactly four hexadecimal digits
+			auto digits = text.substr(position, 4);
+
+			if (digits.size() < 4 || !std::all_of(digits.begin(), digits.end(), [](unsigned char c) { return std::isxdigit(c) != 0; })) {
+				throw JobFileException("Expected four hexadecimal digits after \\u at character " + std::to_string(position) + ".");
+			}
+
+			// The settings are ASCII, other characters are replaced
+			auto code = std::stoi(digits, nullptr, 16);
+
+			result += code < 128 ? (char)code : '?';
+			position += 4;
+			break;
+		}
+		default: result += character; break;
+		}
+	}
+
+	expect(text, position, '"');
+
+	return result;
+}
+
+std::string JobFile::parseValue(const std::string& text, std::size_t& position)
+{
+	skipWhitespace(text, position);
+
+	if (position >= text.size()) {
+		throw JobFileException("Unexpected end of the file.");
+	}
+
+	if (text[position] == '"') {
+		return parseString(text, position);
+	}
+
+	// The arrays of the scalars are stored as lists
+	if (text[position] == '[') {
+		std::string result;
+
+		position++;
+		skipWhitespace(text, position);
+
+		for (auto first = true; position < text.size() && text[position] != ']'; first = false) {
+			if (!first) {
+				expect(text, position, ',');
+				result += ',';
+			}
+
+			result += parseValue(text, position);
+			skipWhitespace(text, position);
+		}
+
+		expect(text, position, ']');
+
+		return result;
+	}
+
+	// Numbers, true, false and null
+	auto end = position;
+
+	while (end < text.size() && (std::isalnum((unsigned char)text[end]) || text[end] == '.' || text[end] == '-' || text[end] == '+')) {
+		end++;
+	}
+
+	if (end == position) {
+		throw JobFileException("Unexpected character " + std::string(1, text[position]) + " at character " + std::to_string(position) + ".");
+	}
+
+	auto token = text.substr(position, end - position);
+	position = end;
+
+	return token == "null" ? "" : token;
+}
+
+std::map<std::string, std::string> JobFile::parseSettings(const std::string& text, std::size_t& position)
+{
+	std::map<std::string, std::string> settings;
+
+	expect(text, position, '{');
+	skipWhitespace(text, position);
+
+	while (position < text.size() && text[position] != '}') {
+		if (!settings.empty()) {
+			expect(text, position, ',');
+		}
+
+		auto key = parseString(text, position);
+
+		expect(text, position, ':');
+		settings[key] = parseValue(text, position);
+		skipWhitespace(text, position);
+	}
+
+	expect(text, position, '}');
+
+	return settings;
+}
+
+std::vector<JobFile::Entry> JobFile::parseJobs(const std::string& text, std::size_t& position)
+{
+	std::vector<Entry> entries;
+
+	expect(text, position, '[');
+	skipWhitespace(text, position);
+
+	while (position < text.size() && text[position] != ']') {
+		if (!entries.empty()) {
+			expect(text, position, ',');
+		}
+
+		auto settings = parseSettings(text, position);
+		auto name = settings.find("name");
+		Entry entry{ name != settings.end() ? name->second : "job " + std::to_string(entries.size() + 1), settings };
+
+		entry.settings.erase("name");
+		entries.push_back(entry);
+		skipWhitespace(text, position);
+	}
+
+	expect(text, position, ']');
+
+	return entries;
+}
+
+std::vector<JobFile::Entry> JobFile::parseJson(std::istream& stream)
+{
+	std::string text((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+	std::size_t position = 0;
+	std::vector<Entry> entries;
+	std::map<std::string, std::string> defaults;
+
+	skipWhitespace(text, position);
+
+	if (position < text.size() && text[position] == '[') {
+		entries = parseJobs(text, position);
+	}
+	else
+	{
+		expect(text, position, '{');
+		skipWhitespace(text, position);
+
+		for (auto first = true; position < text.size() && text[position] != '}'; first = false) {
+			if (!first) {
+				expect(text, position, ',');
+			}
+
+			auto key = parseString(text, position);
+
+			expect(text, position, ':');
+
+			if (key == "defaults") {
+				defaults = parseSettings(text, position);
+			}
+			else if (key == "jobs") {
+				entries = parseJobs(text, position);
+			}
+			else
+			{
+				throw JobFileException("Unknown top level key " + key + ".");
+			}
+
+			skipWhitespace(text, position);
+		}
+
+		expect(text, position, '}');
+	}
+
+	skipWhitespace(text, position);
+
+	if (position != text.size()) {
+		throw JobFileException("Unexpected content after the jobs at character " + std::to_string(position) + ".");
+	}
+
+	applyDefaults(entries, defaults);
+
+	return entries;
+}
@@ -0,0 +1,91 @@
+#pragma once // Include guard
+
+#include <istream>
+#include <map>
+#include <string>
+#include <vector>
+
+/**
+* Static class for reading the batch job files
+* \nThe jobs can be given in INI or JSON format, the format is chosen by the .json extension or the first character.
+* \nEvery job is a set of key - value settings, the lists are separated by commas.
+* \nThe settings of the defaults section (INI) or object (JSON) are applied to every job, the jobs can override them.
+*
+* INI format:
+* \n[defaults]
+* \nvelocity = 1.75
+* \n[step]
+* \nschemes = explicit, lax-wendroff
+*
+* JSON format:
+* \n{ "defaults": { "velocity": 1.75 }, "jobs": [ { "name": "step", "schemes": ["explicit", "lax-wendroff"] } ] }
+* \nThe top level can also be the array of the jobs.
+*
+* The JobFile class provides:
+* \n-read function to read the jobs from a file
+* \n-parseIni and parseJson functions to read the jobs from a stream
+*/
+class JobFile
+{
+public:
+	/**
+	* The settings of one job
+	*/
+	struct Entry
+	{
+		std::string name;
+		std::map<std::string, std::string> settings;
+	};
+
+private:
+	/**
+	* Private method that applies the default settings to the jobs, the settings of the jobs are kept
+	*/
+	static void applyDefaults(std::vector<Entry>& entries, const std::map<std::string, std::string>& defaults);
+
+	/**
+	* Private method that removes the leading and trailing whitespaces
+	*/
+	static std::string trim(const std::string& text);
+
+	/**
+	* Private methods of the JSON parser, position is the index of the next unread character
+	*/
+	static void skipWhitespace(const std::string& text, std::size_t& position);
+	static void expect(const std::string& text, std::size_t& position, char character);
+	static std::string parseString(const std::string& text, std::size_t& position);
+	static std::string parseValue(const std::string& text, std::size_t& position);
+	static std::map<std::string, std::string> parseSettings(const std::string& text, std::size_t& position);
+	static std::vector<Entry> parseJobs(const std::string& text, std::size_t& position);
+
+public:
+	// Delete default member functions to emphasize that the class should only be used to access the static functions.
+	JobFile() = delete;
+	~JobFile() = delete;
+	JobFile(const JobFile& that) = delete;
+	JobFile & operator=(const JobFile&) = delete;
+
+	/**
+	* Static public method that reads the jobs from a file
+	* Throws JobFileException if the file cannot be opened or parsed
+	* @param path std::string - The path of the job file
+	* @return std::vector<Entry> - The jobs in the order of the file
+	*/
+	static std::vector<Entry> read(const std::string& path);
+
+	/**
+	* Static public method that reads the jobs in INI format
+	* Throws JobFileException on syntax errors
+	* @param stream std::istream& - The stream to read from
+	* @return std::vector<Entry> - The jobs in the order of the stream
+	*/
+	static std::vector<Entry> parseIni(std::istream& stream);
+
+	/**
+	* Static public method that reads the jobs in JSON format
+	* Throws JobFileException on syntax errors
+	* @param stream std::istream& - The stream to read from
+	* @return std::vector<Entry> - The jobs in the order of the stream
+	*/
+	static std::vector<Entry> parseJson(std::istream& stream);
+};
@@ -0,0 +1,7 @@
+#include "JobFileException.h"
+
+JobFileException::JobFileException(const std::string& message)
+	: std::runtime_error("Invalid job file! " + message)
+{
+
+}
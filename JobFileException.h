@@ -0,0 +1,18 @@
+#pragma once // Include guard
+
+#include <stdexcept>
+#include <string>
+
+/**
+* Custom runtime exception class to handle invalid batch job files
+* It is thrown for syntax errors, unknown settings and invalid values, before any job is started
+*/
+class JobFileException : public std::runtime_error
+{
+public:
+	/**
+	* Constructor for the exception that will call the base class's constuctor to produce the error message
+	* @param message std::string - The description of the error
+	*/
+	JobFileException(const std::string& message);
+};
@@ -0,0 +1,292 @@
+#pragma once // Include guard
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include "Kernels.h"
+
+/*
+* The loops of the dispatched kernels, the header is only included by the translation units of the instruction sets,
+* after the target of the compiler is set. The loops are written in blocks of a fixed number of lanes (two 64-byte
+* registers of AVX-512), the compiler maps a block to one, two or four registers, so the narrower instruction sets
+* only need more instructions per block. The functions are in an anonymous namespace and call no library function,
+* so no code compiled for a wide instruction set is shared with the other translation units by the linker.
+*/
+
+// The products are rounded before the additions in every variant, the fused multiply-adds would change the results.
+// The floating point exceptions are not observed, so GCC may evaluate both sides of the selects (no-trapping-math)
+#if defined(_MSC_VER)
+#pragma fp_contract(off)
+#elif defined(__clang__)
+#pragma STDC FP_CONTRACT OFF
+#elif defined(__GNUC__)
+#pragma GCC optimize("fp-contract=off", "no-trapping-math")
+#endif
+
+namespace
+{
+	template <typename T>
+	struct Lanes
+	{
+		static const std::size_t count = 128 / sizeof(T);
+	};
+
+	template <typename T>
+	void axpyLoop(T a, const T* __restrict x, T* __restrict y, std::size_t count)
+	{
+		const auto lanes = Lanes<T>::count;
+		std::size_t i = 0;
+
+		for (; i + lanes <= count; i += lanes) {
+			for (std::size_t l = 0; l < lanes; l++) {
+				y[i + l] += a * x[i + l];
+			}
+		}
+
+		for (; i < count; i++) {
+			y[i] += a * x[i];
+		}
+	}
+
+	template <typename T>
+	void scaleLoop(T a, const T* __restrict x, T* __restrict y, std::size_t count)
+	{
+		const auto lanes = Lanes<T>::count;
+		std::size_t i = 0;
+
+		for (; i + lanes <= count; i += lanes) {
+			for (std::size_t l = 0; l < lanes; l++) {
+				y[i + l] = a * x[i + l];
+			}
+		}
+
+		for (; i < count; i++) {
+			y[i] = a * x[i];
+		}
+	}
+
+	// The partial sums are added pairwise, the order does not depend on the instruction set
+	template <typename S>
+	S reduce(S* partial, std::size_t lanes)
+	{
+		for (auto width = lanes / 2; width > 0; width /= 2) {
+			for (std::size_t l = 0; l < width; l++) {
+				partial[l] += partial[l + width];
+			}
+		}
+
+		return partial[0];
+	}
+
+	template <typename T>
+	T dotLoop(const T* x, const T* y, std::size_t count)
+	{
+		const auto lanes = Lanes<T>::count;
+		T partial[Lanes<T>::count] = {};
+		std::size_t i = 0;
+
+		for (; i + lanes <= count; i += lanes) {
+			for (std::size_t l = 0; l < lanes; l++) {
+				partial[l] += x[i + l] * y[i + l];
+			}
+		}
+
+		// The remaining elements are added to the first partial sums
+		for (std::size_t l = 0; i + l < count; l++) {
+			partial[l] += x[i + l] * y[i + l];
+		}
+
+		return reduce(partial, lanes);
+	}
+
+	template <typename T>
+	void conservativeUpdateLoop(const T* values, const T* fluxes, T* __restrict next, T ratio, std::size_t count)
+	{
+		const auto lanes = Lanes<T>::count;
+		std::size_t i = 0;
+
+		for (; i + lanes <= count; i += lanes) {
+			for (std::size_t l = 0; l < lanes; l++) {
+				next[i + l] = values[i + l] - ratio * (fluxes[i + l] - fluxes[i + l - 1]);
+			}
+		}
+
+		for (; i < count; i++) {
+			next[i] = values[i] - ratio * (fluxes[i] - fluxes[i - 1]);
+		}
+	}
+
+	template <typename T>
+	T maximumLoop(const T* x, std::size_t count)
+	{
+		const auto lanes = Lanes<T>::count;
+		T partial[Lanes<T>::count];
+		std::size_t i = 0;
+
+		for (std::size_t l = 0; l < lanes; l++) {
+			partial[l] = x[0];
+		}
+
+		for (; i + lanes <= count; i += lanes) {
+			for (std::size_t l = 0; l < lanes; l++) {
+				partial[l] = x[i + l] > partial[l] ? x[i + l] : partial[l];
+			}
+		}
+
+		for (std::size_t l = 0; i + l < count; l++) {
+			partial[l] = x[i + l] > partial[l] ? x[i + l] : partial[l];
+		}
+
+		for (std::size_t l = 1; l < lanes; l++) {
+			partial[0] = partial[l] > partial[0] ? partial[l] : partial[0];
+		}
+
+		return partial[0];
+	}
+
+	// The single precision values are converted, so the sums of both value types are accumulated in double precision
+	template <typename T, int P>
+	double sumOfPowersLoop(const T* x, std::size_t count)
+	{
+		const auto lanes = Lanes<double>::count;
+		double partial[Lanes<double>::count] = {};
+		std::size_t i = 0;
+
+		for (; i + lanes <= count; i += lanes) {
+			for (std::size_t l = 0; l < lanes; l++) {
+				double value = x[i + l];
+
+				partial[l] += P == 1 ? value : value * value;
+			}
+		}
+
+		for (std::size_t l = 0; i + l < count; l++) {
+			double value = x[i + l];
+
+			partial[l] += P == 1 ? value : value * value;
+		}
+
+		return reduce(partial, lanes);
+	}
+
+	template <typename T>
+	double sumOfPowersKernel(const T* x, std::size_t count, int p)
+	{
+		return p == 1 ? sumOfPowersLoop<T, 1>(x, count) : sumOfPowersLoop<T, 2>(x, count);
+	}
+
+	inline double fromBits(std::int64_t bits)
+	{
+		double value;
+
+		std::memcpy(&value, &bits, sizeof(value));
+
+		return value;
+	}
+
+	inline std::int64_t toBits(double value)
+	{
+		std::int64_t bits;
+
+		std::memcpy(&bits, &value, sizeof(bits));
+
+		return bits;
+	}
+
+	// Adding 1.5 * 2^52 rounds to the nearest integer, which is then in the low bits of the mantissa
+	const double roundingShift = 6755399441055744.0;
+
+	// 2^n for an integer valued n in -1022 ... 1023, built from the exponent bits
+	inline double power2(double n)
+	{
+		return fromBits((toBits(n + roundingShift) - toBits(roundingShift) + 1023) << 52);
+	}
+
+	// Exponential of one value: exp(x) = 2^n * exp(r), where x = n * ln(2) + r and |r| <= ln(2) / 2.
+	// The selects and the integer operations have vector forms on every instruction set, so the loop is vectorised
+	template <typename T>
+	inline T expValue(T argument)
+	{
+		const double minimum = -746.0, maximum = 710.0, log2e = 1.4426950408889634;
+		const double ln2High = 6.93145751953125e-1, ln2Low = 1.42860682030941723212e-6;
+
+		// The arguments below the minimum give zero, they are replaced to avoid the slow subnormal arithmetic.
+		// The comparisons are false for NaN, so it is kept and gives NaN like std::exp
+		double x = argument;
+		auto underflow = x < minimum;
+
+		x = underflow ? 0.0 : x;
+		x = x > maximum ? maximum : x;
+
+		// Round to the nearest integer and reduce the argument in two steps (Cody-Waite)
+		auto n = (x * log2e + roundingShift) - roundingShift;
+		auto r = (x - n * ln2High) - n * ln2Low;
+
+		// Taylor polynomial up to the 12th order, evaluated with the Estrin scheme for the shorter dependency chains
+		auto r2 = r * r, r4 = r2 * r2, r8 = r4 * r4;
+
+		auto c01 = 1.0 + r;
+		auto c23 = 1.0 / 2 + 1.0 / 6 * r;
+		auto c45 = 1.0 / 24 + 1.0 / 120 * r;
+		auto c67 = 1.0 / 720 + 1.0 / 5040 * r;
+		auto c89 = 1.0 / 40320 + 1.0 / 362880 * r;
+		auto c1011 = 1.0 / 3628800 + 1.0 / 39916800 * r;
+		auto c12 = 1.0 / 479001600;
+
+		auto c07 = (c01 + c23 * r2) + (c45 + c67 * r2) * r4;
+		auto c812 = (c89 + c1011 * r2) + c12 * r4;
+		auto p = c07 + c812 * r8;
+
+		// 2^n is applied in two halves, so the subnormal results and the overflow are rounded like std::exp
+		auto half = (n * 0.5 + roundingShift) - roundingShift;
+		auto value = p * power2(half) * power2(n - half);
+
+		return T(underflow ? 0.0 : value);
+	}
+
+	template <typename T>
+	void expLoop(const T* x, T* result, std::size_t count)
+	{
+		const auto lanes = Lanes<T>::count;
+		T block[Lanes<T>::count];
+		std::size_t i = 0;
+
+		// The block is copied first, the arrays may be the same
+		for (; i + lanes <= count; i += lanes) {
+			for (std::size_t l = 0; l < lanes; l++) {
+				block[l] = x[i + l];
+			}
+
+			for (std::size_t l = 0; l < lanes; l++) {
+				result[i + l] = expValue(block[l]);
+			}
+		}
+
+		for (; i < count; i++) {
+			result[i] = expValue(x[i]);
+		}
+	}
+
+	template <typename T>
+	KernelTable<T> makeKernelTable()
+	{
+		KernelTable<T> table;
+
+		table.axpy = axpyLoop<T>;
+		table.scale = scaleLoop<T>;
+		table.dot = dotLoop<T>;
+		table.conservativeUpdate = conservativeUpdateLoop<T>;
+		table.maximum = maximumLoop<T>;
+		table.sumOfPowers = sumOfPowersKernel<T>;
+		table.exp = expLoop<T>;
+
+		return table;
+	}
+}
+
+/*
+* The definitions of the table functions of a variant, the tables are built on the first call
+*/
+#define DEFINE_KERNEL_TABLES(name) \
+	template <> const KernelTable<float>* name<float>() { static const KernelTable<float> table = makeKernelTable<float>(); return &table; } \
+	template <> const KernelTable<double>* name<double>() { static const KernelTable<double> table = makeKernelTable<double>(); return &table; }
@@ -0,0 +1,40 @@
+#include "Kernels.h"
+
+template <typename T>
+const KernelTable<T>& Kernels::get()
+{
+	// The table is chosen on the first call, the callers read it once per loop
+	static const KernelTable<T>& table = variant<T>(CpuFeatures::selected());
+
+	return table;
+}
+
+template <typename T>
+const KernelTable<T>& Kernels::variant(InstructionSet set)
+{
+	const KernelTable<T>* table = nullptr;
+
+	// Only the table of the requested instruction set is touched, its code must not run on the older processors
+	switch (set) {
+	case InstructionSet::AVX512:
+		table = kernelsAVX512<T>();
+		break;
+	case InstructionSet::AVX2:
+		table = kernelsAVX2<T>();
+		break;
+	default:
+		break;
+	}
+
+	if (table == nullptr && set == InstructionSet::AVX512) {
+		table = kernelsAVX2<T>();
+	}
+
+	return table != nullptr ? *table : *kernelsSSE2<T>();
+}
+
+// Explicit instantiation for the supported value types
+template const KernelTable<float>& Kernels::get<float>();
+template const KernelTable<double>& Kernels::get<double>();
+template const KernelTable<float>& Kernels::variant<float>(InstructionSet set);
+template const KernelTable<double>& Kernels::variant<double>(InstructionSet set);
@@ -0,0 +1,98 @@
+#pragma once // Include guard
+
+#include <cstddef>
+#include "CpuFeatures.h"
+
+/**
+* The table of the dispatched kernels of a value type
+* \nThe reductions (dot, sumOfPowers) accumulate a fixed number of partial sums that does not depend on the width
+* \nof the registers, and the variants are compiled without the contraction into fused multiply-adds, so every
+* \nvariant calculates the same results to the last bit and the instruction set can be forced for comparisons.
+*/
+template <typename T>
+struct KernelTable
+{
+	/**
+	* y[i] += a * x[i]
+	*/
+	void(*axpy)(T a, const T* x, T* y, std::size_t count);
+
+	/**
+	* y[i] = a * x[i]
+	*/
+	void(*scale)(T a, const T* x, T* y, std::size_t count);
+
+	/**
+	* The sum of x[i] * y[i]
+	*/
+	T(*dot)(const T* x, const T* y, std::size_t count);
+
+	/**
+	* Conservative update next[i] = values[i] - ratio * (fluxes[i] - fluxes[i - 1]), fluxes[-1] is read
+	*/
+	void(*conservativeUpdate)(const T* values, const T* fluxes, T* next, T ratio, std::size_t count);
+
+	/**
+	* The largest element, the count must be positive
+	*/
+	T(*maximum)(const T* x, std::size_t count);
+
+	/**
+	* The sum of x[i]^p in double precision for p = 1 or 2
+	*/
+	double(*sumOfPowers)(const T* x, std::size_t count, int p);
+
+	/**
+	* result[i] = e^x[i] calculated in double precision, result may be the same array as x
+	*/
+	void(*exp)(const T* x, T* result, std::size_t count);
+};
+
+/**
+* Static class for the kernels of the hot loops, they are compiled for every instruction set
+* \nin their own translation units (KernelsSSE2.cpp, KernelsAVX2.cpp, KernelsAVX512.cpp) and the variant
+* \nof the selected instruction set is chosen once, so a single binary uses the full width of every processor.
+*
+* The Kernels class provides:
+* \n-get function to retrieve the kernel table of the selected instruction set
+* \n-variant function to retrieve the kernel table of a given instruction set
+*/
+class Kernels
+{
+public:
+	// Delete default member functions to emphasize that the class should only be used to access the static functions.
+	Kernels() = delete;
+	~Kernels() = delete;
+	Kernels(const Kernels& that) = delete;
+	Kernels & operator=(const Kernels&) = delete;
+
+	/**
+	* Static public method that returns the kernels of the instruction set selected by CpuFeatures
+	* @return const KernelTable<T>& - The kernel table (T is float or double)
+	*/
+	template <typename T>
+	static const KernelTable<T>& get();
+
+	/**
+	* Static public method that returns the kernels of an instruction set
+	* The variants that the compiler cannot build fall back to the narrower ones,
+	* \nthe processor must support the instruction set before the kernels are called
+	* @param set InstructionSet - The instruction set
+	* @return const KernelTable<T>& - The kernel table (T is float or double)
+	*/
+	template <typename T>
+	static const KernelTable<T>& variant(InstructionSet set);
+};
+
+/**
+* The kernel tables of the variants, defined by the translation units of the instruction sets,
+* \nthey return nullptr if the compiler cannot build the variant
+*/
+template <typename T>
+const KernelTable<T>* kernelsSSE2();
+
+template <typename T>
+const KernelTable<T>* kernelsAVX2();
+
+template <typename T>
+const KernelTable<T>* kernelsAVX512();
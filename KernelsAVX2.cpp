@@ -0,0 +1,27 @@
+#include <cstddef>
+#include "Kernels.h"
+
+// The AVX2 variant of the kernels, compiled with the target pragma by GCC and Clang and with /arch:AVX2 by MSVC (Assignment.vcxproj)
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+
+#if defined(__clang__)
+#pragma clang attribute push(__attribute__((target("avx2"))), apply_to = function)
+#elif defined(__GNUC__)
+#pragma GCC target("avx2")
+#endif
+
+#include "KernelLoops.h"
+
+DEFINE_KERNEL_TABLES(kernelsAVX2)
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#endif
+
+#else
+
+// The other targets have no AVX2, the generic variant is used
+template <> const KernelTable<float>* kernelsAVX2<float>() { return nullptr; }
+template <> const KernelTable<double>* kernelsAVX2<double>() { return nullptr; }
+
+#endif
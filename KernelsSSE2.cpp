@@ -0,0 +1,7 @@
+#include <cstddef>
+#include "Kernels.h"
+
+// The generic variant of the kernels, compiled with the baseline instruction set of the project (SSE2 on x86 and x64)
+#include "KernelLoops.h"
+
+DEFINE_KERNEL_TABLES(kernelsSSE2)
@@ -1,8 +1,13 @@
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include "Kernels.h"
 #include "LUFactorisation.h"
 
-void LUFactorisation::luFact(const Matrix& a, Matrix& l, Matrix& u, int n) {
-	Matrix temp = a;
-	double mult;
+template <typename T>
+void LUFactorisation::luFact(const Matrix<T>& a, Matrix<T>& l, Matrix<T>& u, int n) {
+	Matrix<T> temp = a;
+	T mult;
 
 	// LU (Doolittle's) decomposition without pivoting
 	for (int k = 0; k < n - 1; k++) {
@@ -34,20 +39,28 @@ void LUFactorisation::luFact(const Matrix& a, Matrix& l, Matrix& u, int n) {
 		for (int j = i; j<n; j++) u[i][j] = temp[i][j];
 }
 
-void LUFactorisation::luSolve(const Matrix& l, const Matrix& u, const std::vector<double>& b, int n, std::vector<double>& x) {	std::vector<double> temp(b);
-	int i, j;
+template <typename T>
+void LUFactorisation::luSolve(const Matrix<T>& l, const Matrix<T>& u, const std::vector<T>& b, int n, std::vector<T>& x) {
+	int i;
+	auto& kernels = Kernels::get<T>();
 
-	// forward substitution for L y = b.
+	// the substitutions run in place in x, so the time steps allocate no temporary vector
+	for (i = 0; i < n; i++) x[i] = b[i];
+
+	// forward substitution for L y = b, the sums of the rows are the dot products of the kernels
 	for (i = 1; i < n; i++)
-		for (j = 0; j < i; j++)
-			temp[i] -= l[i][j] * temp[j];
+		x[i] -= kernels.dot(l[i].data(), x.data(), i);
 
 
 	// back substitution for U x = y.  
 	for (i = n - 1; i >= 0; i--) {
-		for (j = i + 1; j < n; j++) temp[i] -= u[i][j] * temp[j];
-		temp[i] /= u[i][i];
+		x[i] -= kernels.dot(u[i].data() + i + 1, x.data() + i + 1, n - i - 1);
+		x[i] /= u[i][i];
 	}
+}
 
-	// copy solution into x
-	for (i = 0; i<n; i++) x[i] = temp[i];}
\ No newline at end of file
+// Explicit instantiation for the supported value types
+template void LUFactorisation::luFact<float>(const Matrix<float>& a, Matrix<float>& l, Matrix<float>& u, int n);
+template void LUFactorisation::luFact<double>(const Matrix<double>& a, Matrix<double>& l, Matrix<double>& u, int n);
+template void LUFactorisation::luSolve<float>(const Matrix<float>& l, const Matrix<float>& u, const std::vector<float>& b, int n, std::vector<float>& x);
+template void LUFactorisation::luSolve<double>(const Matrix<double>& l, const Matrix<double>& u, const std::vector<double>& b, int n, std::vector<double>& x);
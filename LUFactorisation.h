@@ -8,6 +8,7 @@
 * The LUfactorisation  class provides:
 * \n-luFact function to create the L and U matrices
 * \n-luSolve function to solve the LUx = b equation
+* \nThe functions are explicitly instantiated for float and double in LUFactorisation.cpp
 */
 class LUFactorisation
 {
@@ -26,17 +27,19 @@ public:
 	* @param u Matrix - The upper diagonal matrix
 	* @param n int - Used to output the actual name of the value to be retrieved
 	*/
-	static void luFact(const Matrix& a, Matrix& l, Matrix& u, int n);
+	template <typename T>
+	static void luFact(const Matrix<T>& a, Matrix<T>& l, Matrix<T>& u, int n);
 
 	/**
 	* Static public method
 	* It calculates the x vector using the LUx = b equation
 	* @param l Matrix - The matrix to be factored
 	* @param u Matrix - The lower diagonal matrix
-	* @param b std::vector<double> - The vector with the previous values
+	* @param b std::vector<T> - The vector with the previous values
 	* @param n int - The size of the vector
-	* @param x std::vector<double> - The result vector
+	* @param x std::vector<T> - The result vector of size n (it can be the b vector)
 	*/
-	static void luSolve(const Matrix& l, const Matrix& u, const std::vector<double>& b, int n, std::vector<double>& x);
+	template <typename T>
+	static void luSolve(const Matrix<T>& l, const Matrix<T>& u, const std::vector<T>& b, int n, std::vector<T>& x);
 };
 
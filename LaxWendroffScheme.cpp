@@ -1,27 +1,34 @@
 #include <iostream>
 #include "LaxWendroffScheme.h"
 
-LaxWendroffScheme::LaxWendroffScheme(double xStart, double xEnd, double t, int spacePoints, double u, double cfl, std::ostream& stream)
-	: AbstractScheme(stream, "Lax-Wendroff Scheme", xStart, xEnd, t, spacePoints, u, cfl)
+template <typename T>
+LaxWendroffScheme<T>::LaxWendroffScheme(double xStart, double xEnd, double t, int spacePoints, double u, double cfl)
+	: FluxFormScheme<T>("Lax-Wendroff Scheme", xStart, xEnd, t, spacePoints, u, cfl)
 {
 
 }
 
 // Define the pure virtual function of the base class
-std::vector<double> LaxWendroffScheme::calculateIteration(double t)
+template <typename T>
+void LaxWendroffScheme<T>::calculateFluxes(typename FluxFormScheme<T>::State& state, int first, int last) const
 {
-	std::vector<double> newValues;
-
-	newValues.push_back(left);
-
-	for (auto i = 1; i < spacePoints; i++) {
-		newValues.push_back(currentValues[i] - u * deltaT * ((currentValues[i+1] - currentValues[i-1]) / (2 * deltaX)) 
-			+ 0.5 * std::pow(u, 2) * std::pow(deltaT, 2) * ((currentValues[i+1] - 2 * currentValues[i] + currentValues[i-1]) / std::pow(deltaX, 2)));
+	auto& q = state.currentValues;
+	auto& fluxes = state.fluxes;
+	auto u = static_cast<T>(this->u);
+	auto halfNu = static_cast<T>(0.5 * this->u * state.deltaT / state.deltaX);
+	auto half = static_cast<T>(0.5);
+
+	for (auto i = first; i <= last; i++) {
+		fluxes[i] = u * (half * (q[i] + q[i + 1]) - halfNu * (q[i + 1] - q[i]));
 	}
+}
 
-	newValues.push_back(right);
-
-	currentValues = newValues;
+template <typename T>
+std::vector<Stencil> LaxWendroffScheme<T>::getStencils(double cfl) const
+{
+	return { Stencil{ -1, { 0.5 * cfl * (1 + cfl), 1 - cfl * cfl, -0.5 * cfl * (1 - cfl) }, {} } };
+}
 
-	return currentValues;
-}
\ No newline at end of file
+// Explicit instantiation for the supported value types
+template class LaxWendroffScheme<float>;
+template class LaxWendroffScheme<double>;
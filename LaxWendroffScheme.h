@@ -1,13 +1,21 @@
 #pragma once // Include guard
 
-#include "AbstractScheme.h"
+#include "FluxFormScheme.h"
 
 /**
-* Lax-Wendroff scheme class derived from the Abstract scheme
-* It overrides the default implementation of the approximator function
+* Lax-Wendroff scheme class derived from the Flux-form scheme
+* It overrides the default implementation of the flux function
 */
-class LaxWendroffScheme : public AbstractScheme
+template <typename T = double>
+class LaxWendroffScheme : public FluxFormScheme<T>
 {
+protected:
+	/**
+	* Override the pure virtual function to calculate the Lax-Wendroff fluxes
+	* F(i+1/2) = u * (0.5 * (q(i) + q(i+1)) - 0.5 * cfl * (q(i+1) - q(i)))
+	*/
+	void calculateFluxes(typename FluxFormScheme<T>::State& state, int first, int last) const override;
+
 public:
 	/**
 	* Constructor for the Lax-Wendroff scheme
@@ -16,16 +24,11 @@ public:
 	* @param t double - The timeframe until the calculations should be executed
 	* @param spacePoints int - The number of intervals in the space dimension
 	* @param u double - The velocity of the wave
-	* @param file std::ostream& - The stream to write the results to (default value is std::cout)
 	*/
-	LaxWendroffScheme(double xStart, double xEnd, double t, int spacePoints, double u, double cfl, std::ostream& stream);
+	LaxWendroffScheme(double xStart, double xEnd, double t, int spacePoints, double u, double cfl);
 
 	/**
-	* Override the pure virtual function to approximate using the Lax-Wendroff scheme
-	* It returns a vector of doubles containing the numerical values
-	* @param double t - The current time frame
-	* @return std::vector<double> - The calculated numerical values
+	* Override the stencils with the coefficients of the flux difference of the Lax-Wendroff fluxes
 	*/
-	std::vector<double> calculateIteration(double t) override;
+	std::vector<Stencil> getStencils(double cfl) const override;
 };
-
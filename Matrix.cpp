@@ -1,20 +1,30 @@
+#include <cmath>
+#include <stdexcept>
 #include "Matrix.h"
 
 /*
 *Default constructor (empty matrix)
 */
-Matrix::Matrix() : std::vector<std::vector<double> >() {}
+template <typename T>
+Matrix<T>::Matrix() : vec() {}
 
 /*
 * Alternate constructor - creates a matrix with the given values
 */
-Matrix::Matrix(int Nrows, int Ncols) : std::vector<std::vector<double> >()
+template <typename T>
+Matrix<T>::Matrix(int Nrows, int Ncols) : Matrix(Nrows, Ncols, nullptr) {}
+
+/*
+* Arena constructor - creates a matrix with the storage in the arena
+*/
+template <typename T>
+Matrix<T>::Matrix(int Nrows, int Ncols, MonotonicArena* arena) : vec(arena)
 {
 	//check input
 	if (Nrows < 0 || Ncols < 0) throw std::invalid_argument("matrix size negative");
 
-	// set the size for the rows
-	(*this).resize(Nrows);
+	// set the size for the rows, they are in the arena of the matrix
+	(*this).resize(Nrows, row(arena));
 	// set the size for the columns
 	for (int i = 0; i < Nrows; i++) (*this)[i].resize(Ncols);
 
@@ -26,10 +36,11 @@ Matrix::Matrix(int Nrows, int Ncols) : std::vector<std::vector<double> >()
 /*
 * Copy constructor
 */
-Matrix::Matrix(const Matrix& m) : std::vector<std::vector<double> >()
+template <typename T>
+Matrix<T>::Matrix(const Matrix& m) : vec(m.getArena())
 {
-	// set the size of the rows
-	(*this).resize(m.size());
+	// set the size of the rows, the copy is in the arena of the source
+	(*this).resize(m.size(), row(m.getArena()));
 	// set the size of the columns
 	std::size_t i;
 	for (i = 0; i < m.size(); i++) (*this)[i].resize(m[0].size());
@@ -43,15 +54,17 @@ Matrix::Matrix(const Matrix& m) : std::vector<std::vector<double> >()
 /*
 * accessor method - get the number of rows
 */
-int Matrix::getNrows() const
+template <typename T>
+int Matrix<T>::getNrows() const
 {
-	return size();
+	return this->size();
 }
 
 /*
 * accessor method - get the number of columns
 */
-int Matrix::getNcols() const
+template <typename T>
+int Matrix<T>::getNcols() const
 {
 	return (*this)[0].size();
 }
@@ -59,9 +72,10 @@ int Matrix::getNcols() const
 /*
 * Operator= - assignment
 */
-Matrix& Matrix::operator=(const Matrix& m)
+template <typename T>
+Matrix<T>& Matrix<T>::operator=(const Matrix& m)
 {
-	(*this).resize(m.size());
+	(*this).resize(m.size(), row(getArena()));
 	std::size_t i;
 	std::size_t j;
 	for (i = 0; i < m.size(); i++) (*this)[i].resize(m[0].size());
@@ -73,65 +87,19 @@ Matrix& Matrix::operator=(const Matrix& m)
 }
 
 /*
-* Operator* multiplication of a matrix by a matrix
-*/
-Matrix Matrix::operator*(const Matrix& a) const {
-
-	int nrows = getNrows();
-	int ncols = getNcols();
-
-	// catch invalid matrices
-	if (nrows <= 0 || ncols <= 0) { throw std::out_of_range("Matrix access error"); }
-	if (a.getNrows() <= 0 || a.getNcols() <= 0) { throw std::out_of_range("Matrix access error"); }
-
-	//if the matrix sizes do not match
-	if (ncols != a.getNrows()) throw std::out_of_range("matrix sizes do not match");
-
-	//  matrix to store the result
-	Matrix mmult = Matrix(getNrows(), a.getNcols());
-
-	//matrix multiplication
-	for (int i = 0; i<getNrows(); i++) {
-		for (int j = 0; j<a.getNcols(); j++) {
-			for (int k = 0; k<getNcols(); k++) {
-				mmult[i][j] += ((*this)[i][k] * a[k][j]);
-			}
-		}
-	}
-	return mmult;
-}
-
-
-/*
-* Operator* multiplication of a matrix by a vector
+* accessor method - get the arena of the storage
 */
-std::vector<double> Matrix::operator*(const std::vector<double>& v) const {
-	int nrows = getNrows();
-	int ncols = getNcols();
-
-	// catch invalid matrix, vector
-	if (nrows <= 0 || ncols <= 0) { throw std::out_of_range("Matrix access error"); }
-	if (v.size() <= 0) { throw std::out_of_range("Vector access error"); }
-
-	//if the matrix sizes do not match
-	if (ncols != v.size()) throw std::out_of_range("matrix sizes do not match");
-
-	// matrix to store the multiplication
-	std::vector<double> res(nrows);
-
-	// perform the multiplication
-	for (int i = 0; i<nrows; i++)
-		for (int j = 0; j<ncols; j++) res[i] += ((*this)[i][j] * v[j]);
-
-	// return the result
-	return res;
+template <typename T>
+MonotonicArena* Matrix<T>::getArena() const
+{
+	return vec::get_allocator().getArena();
 }
 
-
 /*
 * Operator== comparison function, returns true if the given matrices are the same
 */
-bool Matrix::operator==(const Matrix& a) const {
+template <typename T>
+bool Matrix<T>::operator==(const Matrix& a) const {
 	int nrows = getNrows();
 	int ncols = getNcols();
 
@@ -149,19 +117,17 @@ bool Matrix::operator==(const Matrix& a) const {
 }
 
 /*
-* Transpose of the matrix
+* Size of the matrix for the evaluation of the expressions, the values are overwritten
 */
-Matrix Matrix::transpose() const
+template <typename T>
+void Matrix<T>::reshape(int Nrows, int Ncols)
 {
-	int nrows = getNrows();
-	int ncols = getNcols();
-
-	// matrix to stoore the transpose
-	Matrix temp(ncols, nrows);
+	if (Nrows < 0 || Ncols < 0) throw std::invalid_argument("matrix size negative");
 
-	for (int i = 0; i < ncols; i++)
-		for (int j = 0; j < nrows; j++)
-			temp[i][j] = (*this)[j][i];
+	(*this).resize(Nrows, row(getArena()));
+	for (int i = 0; i < Nrows; i++) (*this)[i].resize(Ncols);
+}
 
-	return temp;
-}
\ No newline at end of file
+// Explicit instantiation for the supported value types
+template class Matrix<float>;
+template class Matrix<double>;
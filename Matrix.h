@@ -1,23 +1,33 @@
 #pragma once
 
 #include <vector> //we use Vector in Matrix code
+#include "ArenaAllocator.h"
+#include "MatrixExpression.h"
 
 /**
-*  A matrix class for data storage of a 2D array of doubles
+*  A matrix class for data storage of a 2D array of T values (float or double, default value is double)
 *  \n The implementation is derived from the standard container vector std::vector
 *  \n We use private inheritance to base our vector upon the library version whilst
 *  \nallowing usto expose only those base class functions we wish to use - in this
 *  \ncase the array access operator []
+*  \nThe member functions are explicitly instantiated for float and double in Matrix.cpp
 *
 * The Matrix class provides:
 * \n-basic constructors for creating a matrix object from other matrix object,
 * \nor by creating empty matrix of a given size,
 * \n-input and oput operation via >> and << operators using keyboard or file
 * \n-basic operations like access via [] operator, assignment and comparision
+* \n-the arithmetic operators build lazy expressions (see MatrixExpression.h), they are evaluated on assignment
+* \n-the storage of the rows can be taken from the MonotonicArena of a run, the copies stay in the arena of the source
 */
-class Matrix : private std::vector<std::vector<double> > {
-	typedef std::vector<std::vector<double> > vec;
+template <typename T = double>
+class Matrix : public MatrixExpression<Matrix<T> >, private std::vector<std::vector<T, ArenaAllocator<T> >, ArenaAllocator<std::vector<T, ArenaAllocator<T> > > > {
+	typedef std::vector<T, ArenaAllocator<T> > row;
+	typedef std::vector<row, ArenaAllocator<row> > vec;
 public:
+	typedef T value_type;
+	static const bool expensive = false;
+
 	using vec::operator[];  // make the array access operator public within Matrix
 
 	/**
@@ -36,6 +46,14 @@ public:
 	*/
 	Matrix(int Nrows /**< int. number of rows in matrix */, int Ncols /**< int. number of columns in matrix  */);
 
+	/**
+	* Arena constructor.
+	* build a matrix Nrows by Ncols with the storage taken from the arena
+	* @see Matrix(int Nrows, int Ncols)
+	* @exception invalid_argument ("matrix size negative or zero")
+	*/
+	Matrix(int Nrows /**< int. number of rows in matrix */, int Ncols /**< int. number of columns in matrix  */, MonotonicArena* arena /**< MonotonicArena*. arena of the storage, nullptr for the heap */);
+
 	/**
 	* Copy constructor.
 	* build a matrix from another matrix
@@ -44,6 +62,25 @@ public:
 	*/
 	Matrix(const Matrix& m /**< Matrix&. matrix to copy from  */);
 
+	/**
+	* Move constructor.
+	* take the storage of another matrix
+	*/
+	Matrix(Matrix&& m /**< Matrix&&. matrix to move from  */) = default;
+
+	/**
+	* Converting constructor.
+	* build a matrix from a matrix of another value type, the elements are converted to T
+	* @see Matrix(const Matrix& m)
+	*/
+	template <typename S>
+	explicit Matrix(const Matrix<S>& m /**< Matrix<S>&. matrix to convert from  */) : vec(m.getNrows(), row(m.getNrows() > 0 ? m.getNcols() : 0, T(), m.getArena()), m.getArena())
+	{
+		for (int i = 0; i < m.getNrows(); i++)
+			for (int j = 0; j < m.getNcols(); j++)
+				(*this)[i][j] = static_cast<T>(m[i][j]);
+	}
+
 	/**
 	* Normal public get method.
 	* get the number of rows
@@ -67,6 +104,19 @@ public:
 	*/
 	Matrix& operator=(const Matrix& m /**< Matrix&. Matrix to assign from */); // overloaded assignment operator
 
+	/**
+	* Move assignment operator, the matrix takes the storage (and the arena) of the other one
+	* @return Matrix&. the matrix on the left of the assignment
+	*/
+	Matrix& operator=(Matrix&& m /**< Matrix&&. Matrix to move from */) = default;
+
+	/**
+	* Normal public get method.
+	* get the arena of the storage
+	* @return MonotonicArena*. the arena, nullptr for the heap
+	*/
+	MonotonicArena* getArena() const;
+
 
 	/**
 	* Overloaded comparison operator
@@ -78,38 +128,61 @@ public:
 		) const; // overloaded comparison operator
 
 	/**
-	* Overloaded *operator that returns a Matrix.
-	* It Performs matrix by matrix multiplication.
-	* @see operator*(const Matrix & a) const
-	* @exception out_of_range ("Matrix access error")
-	* One or more of the matrix have a zero size
-	* @exception std::out_of_range ("uncompatible matrix sizes")
-	* Number of columns in first matrix do not match number of columns in second matrix
-	* @return Matrix. matrix-matrix product
+	* Expression constructor.
+	* build a matrix by evaluating a matrix expression
+	* @see MatrixExpression
 	*/
-	//
-	Matrix operator*(const Matrix & a /**< Matrix. matrix to multiply by */) const;
+	template <typename E>
+	Matrix(const MatrixExpression<E>& e /**< MatrixExpression<E>&. expression to evaluate  */) : vec()
+	{
+		reshape(e.self().getNrows(), e.self().getNcols());
+		e.self().evaluateTo(*this);
+	}
 
 	/**
-	* Overloaded *operator that returns a Vector.
-	* It Performs matrix by vector multiplication.
-	* @see operator*(const Matrix & a)const
-	* @exception std::out_of_range ("Matrix access error")
-	* matrix has a zero size
-	* @exception std::out_of_range ("Vector access error")
-	* vector has a zero size
-	* @exception std::out_of_range ("uncompatible matrix-vector sizes")
-	* Number of columns in matrix do not match the vector size
-	* @return Vector. matrix-vector product
+	* Expression assignment operator
+	* The matrix products are evaluated with the blocked kernel, the other expressions in one fused loop.
+	* If the expression reads the matrix itself, it is evaluated to a temporary matrix first.
+	* @return Matrix&. the matrix on the left of the assignment
 	*/
-	//
-	std::vector<double> operator*(const std::vector<double> & v /**< Vector. Vector to multiply by */) const;
+	template <typename E>
+	Matrix& operator=(const MatrixExpression<E>& e /**< MatrixExpression<E>&. expression to evaluate */)
+	{
+		if (e.self().aliases(this)) {
+			Matrix temp(e);
+			vec::swap(temp);
+		}
+		else
+		{
+			reshape(e.self().getNrows(), e.self().getNcols());
+			e.self().evaluateTo(*this);
+		}
 
+		return *this;
+	}
+
+	/**
+	* Element access of the expressions
+	* @return T. the element in row i and column j
+	*/
+	T operator()(int i, int j) const { return (*this)[i][j]; }
+
+	/**
+	* public method that tells if the matrix is the given object, the expressions use it to detect aliasing
+	* @return bool. true if the matrix is at the address
+	*/
+	bool aliases(const void* matrix) const { return this == matrix; }
+
+	/**
+	* public method that returns the lazy transpose of the matrix.
+	* The elements are read with swapped indices when the expression is evaluated, no matrix is built
+	* @return MatrixTranspose<Matrix>. matrix transpose expression
+	*/
+	MatrixTranspose<Matrix> transpose() const { return MatrixTranspose<Matrix>(*this); }
 
+private:
 	/**
-	* public method that returns the transpose of the matrix.
-	* It returns the transpose of matrix
-	* @return Matrix.  matrix transpose
+	* private method that sets the size of the matrix, the existing rows are reused
 	*/
-	Matrix transpose() const;
-};
\ No newline at end of file
+	void reshape(int Nrows, int Ncols);
+};
\ No newline at end of file
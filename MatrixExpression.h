@@ -0,0 +1,317 @@
+#ifndef MATRIXEXPRESSION_H // Old style include guard to support the .tpp template file inclusion
+#define MATRIXEXPRESSION_H
+
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+template <typename T> class Matrix;
+
+/**
+* Base class of the lazily evaluated matrix expressions (curiously recurring template pattern)
+* \nThe operators only build the expression, it is evaluated when it is assigned to a Matrix:
+* \n-the element-wise sums, differences, scalings and transposes are fused into one loop over the tiles of the result
+* \n-the matrix products are evaluated with the blocked kernel, their operands are read in place,
+* \nonly the operands that are products themselves are evaluated to a temporary matrix
+* \nEvery expression provides getNrows, getNcols, the element access operator()(i, j), evaluateTo and aliases functions,
+* \nthe expensive flag tells if reading its elements costs more than a few operations.
+* \nThe expressions keep a reference to the Matrix and std::vector operands, so they must not outlive them.
+*/
+template <typename E>
+class MatrixExpression
+{
+public:
+	/**
+	* Function that returns the derived expression
+	* @return const E& - The expression
+	*/
+	const E& self() const { return static_cast<const E&>(*this); }
+};
+
+/**
+* Base class of the lazily evaluated vector expressions (curiously recurring template pattern)
+* \nThe expressions are evaluated when they are converted to a std::vector or passed to the assign function.
+* \nThe matrix-vector products read the vector operand once per row, so it is evaluated to a temporary vector
+* \nif it is an expression, and the products of matrix products are reassociated, (A * B) * v is A * (B * v).
+*/
+template <typename E>
+class VectorExpression
+{
+public:
+	/**
+	* Function that returns the derived expression
+	* @return const E& - The expression
+	*/
+	const E& self() const { return static_cast<const E&>(*this); }
+
+	/**
+	* Conversion operator that evaluates the expression to a new vector
+	* @return std::vector<T> - The values of the expression
+	*/
+	template <typename T>
+	operator std::vector<T>() const;
+};
+
+/**
+* The way an operand is stored in an expression, the matrices are referenced, the expressions are copied
+*/
+template <typename E>
+struct ExpressionStorage
+{
+	typedef const E type;
+};
+
+template <typename T>
+struct ExpressionStorage<Matrix<T>>
+{
+	typedef const Matrix<T>& type;
+};
+
+/**
+* Element-wise operations of the expressions
+*/
+struct ElementwiseAdd
+{
+	template <typename T>
+	static T apply(T a, T b) { return a + b; }
+};
+
+struct ElementwiseSubtract
+{
+	template <typename T>
+	static T apply(T a, T b) { return a - b; }
+};
+
+/**
+* Element-wise sum or difference of two matrix expressions of the same size
+* Throws std::out_of_range if the sizes do not match
+*/
+template <typename L, typename R, typename Op>
+class MatrixElementwise : public MatrixExpression<MatrixElementwise<L, R, Op>>
+{
+	typename ExpressionStorage<L>::type left;
+	typename ExpressionStorage<R>::type right;
+
+public:
+	typedef typename L::value_type value_type;
+	static const bool expensive = L::expensive || R::expensive;
+
+	MatrixElementwise(const L& left, const R& right);
+
+	int getNrows() const { return left.getNrows(); }
+	int getNcols() const { return left.getNcols(); }
+	value_type operator()(int i, int j) const { return Op::apply(left(i, j), right(i, j)); }
+	bool aliases(const void* matrix) const { return left.aliases(matrix) || right.aliases(matrix); }
+
+	/**
+	* Function that writes the values of the expression to a matrix of the same size
+	* @param result Matrix<value_type>& - The result, it must not be an operand of the expression
+	*/
+	void evaluateTo(Matrix<value_type>& result) const;
+};
+
+/**
+* Matrix expression multiplied by a scalar
+*/
+template <typename E>
+class MatrixScaled : public MatrixExpression<MatrixScaled<E>>
+{
+	typename E::value_type factor;
+	typename ExpressionStorage<E>::type expression;
+
+public:
+	typedef typename E::value_type value_type;
+	static const bool expensive = E::expensive;
+
+	MatrixScaled(value_type factor, const E& expression) : factor(factor), expression(expression) {}
+
+	int getNrows() const { return expression.getNrows(); }
+	int getNcols() const { return expression.getNcols(); }
+	value_type operator()(int i, int j) const { return factor * expression(i, j); }
+	bool aliases(const void* matrix) const { return expression.aliases(matrix); }
+
+	/**
+	* Function that writes the values of the expression to a matrix of the same size
+	* @param result Matrix<value_type>& - The result, it must not be an operand of the expression
+	*/
+	void evaluateTo(Matrix<value_type>& result) const;
+};
+
+/**
+* Transpose of a matrix expression, the elements are read with swapped indices
+*/
+template <typename E>
+class MatrixTranspose : public MatrixExpression<MatrixTranspose<E>>
+{
+	typename ExpressionStorage<E>::type expression;
+
+public:
+	typedef typename E::value_type value_type;
+	static const bool expensive = E::expensive;
+
+	explicit MatrixTranspose(const E& expression) : expression(expression) {}
+
+	int getNrows() const { return expression.getNcols(); }
+	int getNcols() const { return expression.getNrows(); }
+	value_type operator()(int i, int j) const { return expression(j, i); }
+	bool aliases(const void* matrix) const { return expression.aliases(matrix); }
+
+	/**
+	* Function that writes the values of the expression to a matrix of the same size
+	* @param result Matrix<value_type>& - The result, it must not be an operand of the expression
+	*/
+	void evaluateTo(Matrix<value_type>& result) const;
+};
+
+/**
+* Matrix-matrix product, evaluated with the blocked kernel on assignment
+* Throws std::out_of_range if an operand is empty or the sizes do not match
+*/
+template <typename L, typename R>
+class MatrixProduct : public MatrixExpression<MatrixProduct<L, R>>
+{
+	typename ExpressionStorage<L>::type left;
+	typename ExpressionStorage<R>::type right;
+
+public:
+	typedef typename L::value_type value_type;
+	static const bool expensive = true;
+
+	MatrixProduct(const L& left, const R& right);
+
+	int getNrows() const { return left.getNrows(); }
+	int getNcols() const { return right.getNcols(); }
+	bool aliases(const void* matrix) const { return left.aliases(matrix) || right.aliases(matrix); }
+	const L& getLeft() const { return left; }
+	const R& getRight() const { return right; }
+
+	/**
+	* Function that returns one element of the product, it is a dot product of a row and a column
+	*/
+	value_type operator()(int i, int j) const;
+
+	/**
+	* Function that writes the product to a matrix of the same size with the blocked kernel
+	* @param result Matrix<value_type>& - The result, it must not be an operand of the expression
+	*/
+	void evaluateTo(Matrix<value_type>& result) const;
+};
+
+/**
+* Leaf of the vector expressions referencing a std::vector
+*/
+template <typename T>
+class VectorReference : public VectorExpression<VectorReference<T>>
+{
+	const std::vector<T>& values;
+
+public:
+	typedef T value_type;
+	static const bool expensive = false, leaf = true;
+
+	explicit VectorReference(const std::vector<T>& values) : values(values) {}
+
+	std::size_t size() const { return values.size(); }
+	T operator[](std::size_t i) const { return values[i]; }
+	const T* data() const { return values.data(); }
+	bool aliases(const void* vector) const { return &values == vector; }
+	void evaluateTo(std::vector<T>& result) const { result = values; }
+};
+
+/**
+* Element-wise sum or difference of two vector expressions of the same size
+* Throws std::out_of_range if the sizes do not match
+*/
+template <typename L, typename R, typename Op>
+class VectorElementwise : public VectorExpression<VectorElementwise<L, R, Op>>
+{
+	const L left;
+	const R right;
+
+public:
+	typedef typename L::value_type value_type;
+	static const bool expensive = L::expensive || R::expensive, leaf = false;
+
+	VectorElementwise(const L& left, const R& right);
+
+	std::size_t size() const { return left.size(); }
+	value_type operator[](std::size_t i) const { return Op::apply(left[i], right[i]); }
+	bool aliases(const void* vector) const { return left.aliases(vector) || right.aliases(vector); }
+
+	/**
+	* Function that writes the values of the expression to a vector of the same size
+	* @param result std::vector<value_type>& - The result, it must not be an operand of the expression
+	*/
+	void evaluateTo(std::vector<value_type>& result) const;
+};
+
+/**
+* Vector expression multiplied by a scalar
+*/
+template <typename E>
+class VectorScaled : public VectorExpression<VectorScaled<E>>
+{
+	typename E::value_type factor;
+	const E expression;
+
+public:
+	typedef typename E::value_type value_type;
+	static const bool expensive = E::expensive, leaf = false;
+
+	VectorScaled(value_type factor, const E& expression) : factor(factor), expression(expression) {}
+
+	std::size_t size() const { return expression.size(); }
+	value_type operator[](std::size_t i) const { return factor * expression[i]; }
+	bool aliases(const void* vector) const { return expression.aliases(vector); }
+
+	/**
+	* Function that writes the values of the expression to a vector of the same size
+	* @param result std::vector<value_type>& - The result, it must not be an operand of the expression
+	*/
+	void evaluateTo(std::vector<value_type>& result) const;
+};
+
+/**
+* Matrix-vector product, every element is the dot product of a row and the vector
+* Throws std::out_of_range if an operand is empty or the sizes do not match
+*/
+template <typename M, typename V>
+class MatrixVectorProduct : public VectorExpression<MatrixVectorProduct<M, V>>
+{
+	typename ExpressionStorage<M>::type matrix;
+	const V vector;
+
+public:
+	typedef typename M::value_type value_type;
+	static const bool expensive = M::expensive || !V::leaf, leaf = false;
+
+	MatrixVectorProduct(const M& matrix, const V& vector);
+
+	std::size_t size() const { return matrix.getNrows(); }
+	bool aliases(const void* target) const { return matrix.aliases(target) || vector.aliases(target); }
+
+	/**
+	* Function that returns one element of the product
+	*/
+	value_type operator[](std::size_t i) const;
+
+	/**
+	* Function that writes the product to a vector of the same size, the operands are evaluated once
+	* @param result std::vector<value_type>& - The result, it must not be an operand of the expression
+	*/
+	void evaluateTo(std::vector<value_type>& result) const;
+};
+
+/**
+* Function that evaluates a vector expression to an existing vector, its storage is reused
+* The expression may reference the target, then it is evaluated to a temporary vector first
+* @param target std::vector<T>& - The result
+* @param expression const VectorExpression<E>& - The expression to be evaluated
+*/
+template <typename T, typename E>
+void assign(std::vector<T>& target, const VectorExpression<E>& expression);
+
+// Include the cpp file (which is actually renamned to .tpp) so the Linker will be able to generate the expressions for every operand type
+#include "MatrixExpression.tpp"
+
+#endif // MATRIXEXPRESSION_H
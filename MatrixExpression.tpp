@@ -0,0 +1,382 @@
+#ifdef MATRIXEXPRESSION_H
+
+#include <algorithm>
+#include <stdexcept>
+#include "Kernels.h"
+
+// The size of the tiles of the element-wise loops and of the blocks of the product kernel,
+// a block of the three product operands fits in the L2 cache in double precision
+static const int expressionTile = 32;
+static const int productBlock = 64;
+
+/*
+* The operands that are cheap to read are used in place, the expensive ones (products) are evaluated to a temporary
+*/
+template <typename E>
+const E& evaluateOperand(const E& expression, std::false_type)
+{
+	return expression;
+}
+
+template <typename E>
+Matrix<typename E::value_type> evaluateOperand(const MatrixExpression<E>& expression, std::true_type)
+{
+	return Matrix<typename E::value_type>(expression);
+}
+
+template <typename E>
+std::vector<typename E::value_type> evaluateOperand(const VectorExpression<E>& expression, std::true_type)
+{
+	return expression;
+}
+
+/*
+* The rows of the stored matrices and the stored vectors are contiguous, they are processed by the dispatched kernels,
+* the other operands are read element by element
+*/
+template <typename T>
+void accumulateRow(T* row, T factor, const Matrix<T>& b, int k, int first, int last)
+{
+	Kernels::get<T>().axpy(factor, b[k].data() + first, row + first, last - first);
+}
+
+template <typename T, typename E>
+void accumulateRow(T* row, T factor, const E& b, int k, int first, int last)
+{
+	for (int j = first; j < last; j++) {
+		row[j] += factor * b(k, j);
+	}
+}
+
+template <typename T>
+T rowProduct(const Matrix<T>& a, int i, const VectorReference<T>& v, int ncols)
+{
+	return Kernels::get<T>().dot(a[i].data(), v.data(), ncols);
+}
+
+template <typename T>
+T rowProduct(const Matrix<T>& a, int i, const std::vector<T>& v, int ncols)
+{
+	return Kernels::get<T>().dot(a[i].data(), v.data(), ncols);
+}
+
+template <typename M, typename V>
+typename M::value_type rowProduct(const M& a, int i, const V& v, int ncols)
+{
+	typename M::value_type sum = 0;
+
+	for (int j = 0; j < ncols; j++) {
+		sum += a(i, j) * v[j];
+	}
+
+	return sum;
+}
+
+/*
+* Element-wise evaluation of an expression, the result is written tile by tile so the transposed operands are read within the cache
+*/
+template <typename T, typename E>
+void evaluateElements(Matrix<T>& result, const E& expression, int nrows, int ncols)
+{
+	for (int ii = 0; ii < nrows; ii += expressionTile) {
+		for (int jj = 0; jj < ncols; jj += expressionTile) {
+			auto iEnd = std::min(ii + expressionTile, nrows), jEnd = std::min(jj + expressionTile, ncols);
+
+			for (int i = ii; i < iEnd; i++) {
+				auto& row = result[i];
+
+				for (int j = jj; j < jEnd; j++) {
+					row[j] = expression(i, j);
+				}
+			}
+		}
+	}
+}
+
+template <typename L, typename R, typename Op>
+MatrixElementwise<L, R, Op>::MatrixElementwise(const L& left, const R& right) : left(left), right(right)
+{
+	if (left.getNrows() != right.getNrows() || (left.getNrows() > 0 && left.getNcols() != right.getNcols())) {
+		throw std::out_of_range("matrix sizes do not match");
+	}
+}
+
+template <typename L, typename R, typename Op>
+void MatrixElementwise<L, R, Op>::evaluateTo(Matrix<value_type>& result) const
+{
+	auto&& a = evaluateOperand(left, std::integral_constant<bool, L::expensive>());
+	auto&& b = evaluateOperand(right, std::integral_constant<bool, R::expensive>());
+
+	evaluateElements(result, [&](int i, int j) { return Op::apply(a(i, j), b(i, j)); }, getNrows(), getNcols());
+}
+
+template <typename E>
+void MatrixScaled<E>::evaluateTo(Matrix<value_type>& result) const
+{
+	auto&& a = evaluateOperand(expression, std::integral_constant<bool, E::expensive>());
+
+	evaluateElements(result, [&](int i, int j) { return factor * a(i, j); }, getNrows(), getNcols());
+}
+
+template <typename E>
+void MatrixTranspose<E>::evaluateTo(Matrix<value_type>& result) const
+{
+	auto&& a = evaluateOperand(expression, std::integral_constant<bool, E::expensive>());
+
+	evaluateElements(result, [&](int i, int j) { return a(j, i); }, getNrows(), getNcols());
+}
+
+template <typename L, typename R>
+MatrixProduct<L, R>::MatrixProduct(const L& left, const R& right) : left(left), right(right)
+{
+	// catch invalid matrices
+	if (left.getNrows() <= 0 || left.getNcols() <= 0) { throw std::out_of_range("Matrix access error"); }
+	if (right.getNrows() <= 0 || right.getNcols() <= 0) { throw std::out_of_range("Matrix access error"); }
+
+	//if the matrix sizes do not match
+	if (left.getNcols() != right.getNrows()) throw std::out_of_range("matrix sizes do not match");
+}
+
+template <typename L, typename R>
+typename MatrixProduct<L, R>::value_type MatrixProduct<L, R>::operator()(int i, int j) const
+{
+	value_type sum = 0;
+
+	for (int k = 0; k < left.getNcols(); k++) {
+		sum += left(i, k) * right(k, j);
+	}
+
+	return sum;
+}
+
+/*
+* Blocked i-k-j kernel, the inner loop runs along the rows of the result and of the right operand (the axpy kernel).
+* Every element accumulates the terms in the order of k, so the result is the same as the one of the naive loop.
+*/
+template <typename L, typename R>
+void MatrixProduct<L, R>::evaluateTo(Matrix<value_type>& result) const
+{
+	auto&& a = evaluateOperand(left, std::integral_constant<bool, L::expensive>());
+	auto&& b = evaluateOperand(right, std::integral_constant<bool, R::expensive>());
+	int nrows = getNrows(), ncols = getNcols(), inner = left.getNcols();
+
+	for (int i = 0; i < nrows; i++) {
+		std::fill(result[i].begin(), result[i].end(), value_type(0));
+	}
+
+	for (int ii = 0; ii < nrows; ii += productBlock) {
+		for (int kk = 0; kk < inner; kk += productBlock) {
+			for (int jj = 0; jj < ncols; jj += productBlock) {
+				auto iEnd = std::min(ii + productBlock, nrows), kEnd = std::min(kk + productBlock, inner), jEnd = std::min(jj + productBlock, ncols);
+
+				for (int i = ii; i < iEnd; i++) {
+					auto row = result[i].data();
+
+					for (int k = kk; k < kEnd; k++) {
+						accumulateRow(row, a(i, k), b, k, jj, jEnd);
+					}
+				}
+			}
+		}
+	}
+}
+
+template <typename E>
+template <typename T>
+VectorExpression<E>::operator std::vector<T>() const
+{
+	std::vector<T> result(self().size());
+
+	self().evaluateTo(result);
+
+	return result;
+}
+
+template <typename L, typename R, typename Op>
+VectorElementwise<L, R, Op>::VectorElementwise(const L& left, const R& right) : left(left), right(right)
+{
+	if (left.size() != right.size()) throw std::out_of_range("vector sizes do not match");
+}
+
+template <typename L, typename R, typename Op>
+void VectorElementwise<L, R, Op>::evaluateTo(std::vector<value_type>& result) const
+{
+	auto&& a = evaluateOperand(left, std::integral_constant<bool, L::expensive>());
+	auto&& b = evaluateOperand(right, std::integral_constant<bool, R::expensive>());
+
+	for (std::size_t i = 0; i < result.size(); i++) {
+		result[i] = Op::apply(a[i], b[i]);
+	}
+}
+
+template <typename E>
+void VectorScaled<E>::evaluateTo(std::vector<value_type>& result) const
+{
+	auto&& a = evaluateOperand(expression, std::integral_constant<bool, E::expensive>());
+
+	for (std::size_t i = 0; i < result.size(); i++) {
+		result[i] = factor * a[i];
+	}
+}
+
+template <typename M, typename V>
+MatrixVectorProduct<M, V>::MatrixVectorProduct(const M& matrix, const V& vector) : matrix(matrix), vector(vector)
+{
+	// catch invalid matrix, vector
+	if (matrix.getNrows() <= 0 || matrix.getNcols() <= 0) { throw std::out_of_range("Matrix access error"); }
+	if (vector.size() <= 0) { throw std::out_of_range("Vector access error"); }
+
+	//if the matrix sizes do not match
+	if ((std::size_t)matrix.getNcols() != vector.size()) throw std::out_of_range("matrix sizes do not match");
+}
+
+template <typename M, typename V>
+typename MatrixVectorProduct<M, V>::value_type MatrixVectorProduct<M, V>::operator[](std::size_t i) const
+{
+	return rowProduct(matrix, (int)i, vector, matrix.getNcols());
+}
+
+template <typename M, typename V>
+void MatrixVectorProduct<M, V>::evaluateTo(std::vector<value_type>& result) const
+{
+	// The vector operand is read by every row, so the expressions are evaluated once
+	auto&& a = evaluateOperand(matrix, std::integral_constant<bool, M::expensive>());
+	auto&& v = evaluateOperand(vector, std::integral_constant<bool, !V::leaf>());
+	int nrows = matrix.getNrows(), ncols = matrix.getNcols();
+
+	// The rows of the stored matrices are dot products of the kernels
+	for (int i = 0; i < nrows; i++) {
+		result[i] = rowProduct(a, i, v, ncols);
+	}
+}
+
+template <typename T, typename E>
+void assign(std::vector<T>& target, const VectorExpression<E>& expression)
+{
+	auto& e = expression.self();
+
+	if (e.aliases(&target)) {
+		std::vector<T> result(e.size());
+
+		e.evaluateTo(result);
+		target.swap(result);
+	}
+	else
+	{
+		target.resize(e.size());
+		e.evaluateTo(target);
+	}
+}
+
+/*
+* Operators of the matrix expressions
+*/
+template <typename L, typename R>
+MatrixElementwise<L, R, ElementwiseAdd> operator+(const MatrixExpression<L>& left, const MatrixExpression<R>& right)
+{
+	return MatrixElementwise<L, R, ElementwiseAdd>(left.self(), right.self());
+}
+
+template <typename L, typename R>
+MatrixElementwise<L, R, ElementwiseSubtract> operator-(const MatrixExpression<L>& left, const MatrixExpression<R>& right)
+{
+	return MatrixElementwise<L, R, ElementwiseSubtract>(left.self(), right.self());
+}
+
+template <typename E>
+MatrixScaled<E> operator*(typename E::value_type factor, const MatrixExpression<E>& expression)
+{
+	return MatrixScaled<E>(factor, expression.self());
+}
+
+template <typename L, typename R>
+MatrixProduct<L, R> operator*(const MatrixExpression<L>& left, const MatrixExpression<R>& right)
+{
+	return MatrixProduct<L, R>(left.self(), right.self());
+}
+
+/*
+* Operators of the vector expressions, the std::vector operands are wrapped in references
+*/
+template <typename T>
+VectorReference<T> vectorExpression(const std::vector<T>& values)
+{
+	return VectorReference<T>(values);
+}
+
+template <typename E>
+const E& vectorExpression(const VectorExpression<E>& expression)
+{
+	return expression.self();
+}
+
+template <typename L, typename R>
+auto operator+(const VectorExpression<L>& left, const VectorExpression<R>& right)
+{
+	return VectorElementwise<L, R, ElementwiseAdd>(left.self(), right.self());
+}
+
+template <typename L>
+auto operator+(const VectorExpression<L>& left, const std::vector<typename L::value_type>& right)
+{
+	return left + vectorExpression(right);
+}
+
+template <typename R>
+auto operator+(const std::vector<typename R::value_type>& left, const VectorExpression<R>& right)
+{
+	return vectorExpression(left) + right;
+}
+
+template <typename L, typename R>
+auto operator-(const VectorExpression<L>& left, const VectorExpression<R>& right)
+{
+	return VectorElementwise<L, R, ElementwiseSubtract>(left.self(), right.self());
+}
+
+template <typename L>
+auto operator-(const VectorExpression<L>& left, const std::vector<typename L::value_type>& right)
+{
+	return left - vectorExpression(right);
+}
+
+template <typename R>
+auto operator-(const std::vector<typename R::value_type>& left, const VectorExpression<R>& right)
+{
+	return vectorExpression(left) - right;
+}
+
+template <typename E>
+VectorScaled<E> operator*(typename E::value_type factor, const VectorExpression<E>& expression)
+{
+	return VectorScaled<E>(factor, expression.self());
+}
+
+template <typename M, typename V>
+MatrixVectorProduct<M, V> operator*(const MatrixExpression<M>& matrix, const VectorExpression<V>& vector)
+{
+	return MatrixVectorProduct<M, V>(matrix.self(), vector.self());
+}
+
+template <typename M>
+MatrixVectorProduct<M, VectorReference<typename M::value_type>> operator*(const MatrixExpression<M>& matrix, const std::vector<typename M::value_type>& vector)
+{
+	return MatrixVectorProduct<M, VectorReference<typename M::value_type>>(matrix.self(), vectorExpression(vector));
+}
+
+/*
+* The products of matrix products are reassociated, (A * B) * v is A * (B * v), so no matrix is evaluated
+*/
+template <typename L, typename R, typename V>
+auto operator*(const MatrixProduct<L, R>& matrix, const VectorExpression<V>& vector)
+{
+	return matrix.getLeft() * (matrix.getRight() * vector.self());
+}
+
+template <typename L, typename R>
+auto operator*(const MatrixProduct<L, R>& matrix, const std::vector<typename L::value_type>& vector)
+{
+	return matrix.getLeft() * (matrix.getRight() * vector);
+}
+
+#endif // MATRIXEXPRESSION_H
@@ -0,0 +1,65 @@
+#include <algorithm>
+#include <cstdint>
+#include <new>
+#include "MonotonicArena.h"
+
+const std::size_t MonotonicArena::alignment;
+
+MonotonicArena::MonotonicArena(std::size_t _initialBlockSize)
+	: current(nullptr), remaining(0), usedBytes(0), nextBlockSize(_initialBlockSize), initialBlockSize(_initialBlockSize)
+{
+
+}
+
+MonotonicArena::~MonotonicArena()
+{
+	release();
+}
+
+void* MonotonicArena::allocate(std::size_t bytes)
+{
+	// Every allocation starts on an aligned address, so the padding is added to the size
+	bytes = (std::max(bytes, (std::size_t)1) + alignment - 1) & ~(alignment - 1);
+
+	if (bytes > remaining) {
+		// The large requests get their own block, the following blocks are not smaller
+		auto size = std::max(nextBlockSize, bytes);
+		auto data = static_cast<char*>(::operator new(size + alignment));
+
+		blocks.push_back(Block{ data, size });
+		current = reinterpret_cast<char*>((reinterpret_cast<std::uintptr_t>(data) + alignment - 1) & ~(std::uintptr_t)(alignment - 1));
+		remaining = size;
+		nextBlockSize = 2 * size;
+	}
+
+	auto storage = current;
+
+	current += bytes;
+	remaining -= bytes;
+	usedBytes += bytes;
+
+	return storage;
+}
+
+void MonotonicArena::release()
+{
+	for (auto& block : blocks) {
+		::operator delete(block.data);
+	}
+
+	blocks.clear();
+	current = nullptr;
+	remaining = 0;
+	usedBytes = 0;
+	nextBlockSize = initialBlockSize;
+}
+
+std::size_t MonotonicArena::getUsedBytes() const
+{
+	return usedBytes;
+}
+
+std::size_t MonotonicArena::getBlockCount() const
+{
+	return blocks.size();
+}
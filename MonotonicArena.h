@@ -0,0 +1,75 @@
+#pragma once // Include guard
+
+#include <cstddef>
+#include <vector>
+
+/**
+* A monotonic memory arena for the containers of a single run
+* \nThe storage is taken from the blocks by moving a pointer, the freed storage is not reused,
+* \nall blocks are released at once by the release function or the destructor. The block sizes grow
+* \ngeometrically, so a run needs only a few heap allocations however many containers it creates.
+* \nThe arena is not synchronised, every run (and thread) owns its own arena, so there is no allocator contention.
+*
+* The MonotonicArena class provides:
+* \n-allocate function to take aligned storage from the current block
+* \n-release function to free every block at the end of the run
+* \n-getUsedBytes and getBlockCount functions to inspect the memory of the run
+*/
+class MonotonicArena
+{
+	struct Block
+	{
+		char* data;
+		std::size_t size;
+	};
+
+	std::vector<Block> blocks;
+	char* current;
+	std::size_t remaining, usedBytes, nextBlockSize;
+	const std::size_t initialBlockSize;
+
+public:
+	/**
+	* The alignment of the storage, it is the cache line size like the one of the AlignedAllocator
+	*/
+	static const std::size_t alignment = 64;
+
+	/**
+	* Constructor for an empty arena, the first block is allocated by the first request
+	* @param initialBlockSize std::size_t - The size of the first block in bytes (default value is 64 KiB)
+	*/
+	explicit MonotonicArena(std::size_t initialBlockSize = 1 << 16);
+
+	/**
+	* Destructor that releases the blocks
+	*/
+	~MonotonicArena();
+
+	// The arena owns its blocks, it can not be copied
+	MonotonicArena(const MonotonicArena& that) = delete;
+	MonotonicArena & operator=(const MonotonicArena&) = delete;
+
+	/**
+	* Public method that returns aligned storage, a new block is allocated if the current one is full
+	* @param bytes std::size_t - The size of the storage
+	* @return void* - The storage aligned to the alignment of the arena
+	*/
+	void* allocate(std::size_t bytes);
+
+	/**
+	* Public method that frees every block, the storage allocated before must not be used anymore
+	*/
+	void release();
+
+	/**
+	* Public method that returns the number of the bytes allocated since the last release
+	* @return std::size_t - The number of the bytes
+	*/
+	std::size_t getUsedBytes() const;
+
+	/**
+	* Public method that returns the number of the blocks taken from the heap
+	* @return std::size_t - The number of the blocks
+	*/
+	std::size_t getBlockCount() const;
+};
@@ -0,0 +1,140 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <stdexcept>
+#include "PararealSolver.h"
+
+PararealSolver::PararealSolver(std::shared_ptr<const AbstractScheme<>> _coarse, std::shared_ptr<const AbstractScheme<>> _fine, int _slices, int _maxIterations, double _tolerance, ThreadPool& _pool)
+	: coarse(_coarse), fine(_fine), slices(std::max(_slices, 1)), maxIterations(std::max(_maxIterations, 1)), tolerance(_tolerance), pool(_pool)
+{
+
+}
+
+std::vector<double> PararealSolver::restrictToCoarse(const std::vector<double>& fine, int coarsePoints)
+{
+	auto ratio = ((int)fine.size() - 1) / coarsePoints;
+	std::vector<double> coarse(coarsePoints + 1);
+
+	for (auto i = 0; i <= coarsePoints; i++) {
+		coarse[i] = fine[i * ratio];
+	}
+
+	return coarse;
+}
+
+std::vector<double> PararealSolver::prolongToFine(const std::vector<double>& coarse, int finePoints)
+{
+	auto ratio = finePoints / ((int)coarse.size() - 1);
+	std::vector<double> fine(finePoints + 1);
+
+	for (auto i = 0; i <= finePoints; i++) {
+		auto k = i / ratio, offset = i % ratio;
+
+		fine[i] = offset == 0 ? coarse[k] : coarse[k] + (coarse[k + 1] - coarse[k]) * offset / ratio;
+	}
+
+	return fine;
+}
+
+double PararealSolver::maxDifference(const std::vector<double>& a, const std::vector<double>& b)
+{
+	auto result = 0.0;
+
+	for (std::size_t i = 0; i < a.size(); i++) {
+		result = std::max(result, fabs(a[i] - b[i]));
+	}
+
+	return result;
+}
+
+std::vector<double> PararealSolver::solve(std::function< double(double) > initialFunction, double t, std::ostream& stream, std::ostream* timingStream)
+{
+	typedef std::chrono::steady_clock clock;
+
+	auto finePoints = fine->getSpacePoints(), coarsePoints = coarse->getSpacePoints();
+
+	if (finePoints % coarsePoints != 0) {
+		throw std::invalid_argument("the coarse grid intervals must divide the fine grid intervals");
+	}
+
+	// The coarse sweeps are serial, every slice has its own fine state
+	auto coarseState = coarse->createState();
+	std::vector<std::unique_ptr<SimulationState<>>> fineStates;
+
+	for (auto n = 0; n < slices; n++) {
+		fineStates.push_back(fine->createState());
+	}
+
+	auto slice = t / slices;
+	auto coarsePropagate = [&](const std::vector<double>& values) {
+		return prolongToFine(coarse->propagate(*coarseState, restrictToCoarse(values, coarsePoints), slice), finePoints);
+	};
+
+	// The serial fine solution, Parareal converges to it
+	auto serialStart = clock::now();
+	std::vector<double> serial = fine->discretise(initialFunction);
+
+	for (auto n = 0; n < slices; n++) {
+		serial = fine->propagate(*fineStates[0], serial, slice);
+	}
+
+	std::chrono::duration<double> serialTime = clock::now() - serialStart;
+
+	stream << "\n-----------------------\nParareal: " << coarse->getName() << " / " << fine->getName() << "\n-----------------------\n\n";
+
+	auto parallelStart = clock::now();
+
+	// values[n] is the approximation at the beginning of the slice n, coarseValues[n] the coarse prediction from it
+	std::vector<std::vector<double>> values(slices + 1), coarseValues(slices), fineValues(slices);
+	values[0] = fine->discretise(initialFunction);
+
+	for (auto n = 0; n < slices; n++) {
+		coarseValues[n] = coarsePropagate(values[n]);
+		values[n + 1] = coarseValues[n];
+	}
+
+	for (auto k = 1; k <= maxIterations; k++) {
+		std::vector<std::future<void>> futures;
+
+		// The first k - 1 slices are already exact
+		for (auto n = k - 1; n < slices; n++) {
+			futures.push_back(pool.submit([&, n] { fineValues[n] = fine->propagate(*fineStates[n], values[n], slice); }));
+		}
+
+		for (auto& future : futures) {
+			future.get();
+		}
+
+		// Serial correction sweep: U(n+1) = G(U(n)) + F(U_old(n)) - G(U_old(n))
+		auto change = 0.0;
+
+		for (auto n = k - 1; n < slices; n++) {
+			auto prediction = coarsePropagate(values[n]);
+			std::vector<double> corrected(prediction.size());
+
+			for (std::size_t i = 0; i < corrected.size(); i++) {
+				corrected[i] = prediction[i] + fineValues[n][i] - coarseValues[n][i];
+			}
+
+			change = std::max(change, maxDifference(corrected, values[n + 1]));
+			coarseValues[n] = prediction;
+			values[n + 1] = corrected;
+		}
+
+		stream << "iteration " << k << ": change is " << change << ", difference from the serial solution is " << maxDifference(values[slices], serial) << std::endl;
+
+		if (change < tolerance || k == slices) {
+			break;
+		}
+	}
+
+	std::chrono::duration<double> parallelTime = clock::now() - parallelStart;
+
+	auto& timing = timingStream != nullptr ? *timingStream : stream;
+
+	timing << "serial time is " << serialTime.count() << "s, Parareal time is " << parallelTime.count() << "s on " << pool.size() << " threads" << std::endl;
+	timing << "speedup is " << serialTime.count() / parallelTime.count() << std::endl;
+	stream << std::endl;
+
+	return values[slices];
+}
@@ -0,0 +1,66 @@
+#pragma once // Include guard
+
+#include <functional>
+#include <memory>
+#include <ostream>
+#include <vector>
+#include "AbstractScheme.h"
+#include "ThreadPool.h"
+
+/**
+* Parareal parallel-in-time driver
+* \nThe time interval is split into slices, a cheap coarse scheme predicts the values at the beginning of every
+* \nslice serially, then the accurate fine scheme corrects all slices concurrently on the thread pool.
+* \nThe coarse scheme can use a coarser grid, the number of its intervals must divide the fine one.
+* \nThe schemes are shared by all slices, every slice is propagated with its own simulation state.
+*
+* The PararealSolver class provides:
+* \n-solve function to run the iterations and report the convergence and the speedup
+*/
+class PararealSolver
+{
+	std::shared_ptr<const AbstractScheme<>> coarse, fine;
+	int slices, maxIterations;
+	double tolerance;
+	ThreadPool& pool;
+
+	/**
+	* Private method that injects the fine grid values to the coarse grid
+	*/
+	static std::vector<double> restrictToCoarse(const std::vector<double>& fine, int coarsePoints);
+
+	/**
+	* Private method that linearly interpolates the coarse grid values to the fine grid
+	*/
+	static std::vector<double> prolongToFine(const std::vector<double>& coarse, int finePoints);
+
+	/**
+	* Private method that returns the maximum absolute difference of two vectors
+	*/
+	static double maxDifference(const std::vector<double>& a, const std::vector<double>& b);
+
+public:
+	/**
+	* Constructor for the Parareal driver
+	* \nThe schemes must have their analytical function (and so the boundary values) already set
+	* @param coarse std::shared_ptr<const AbstractScheme<>> - The coarse propagator
+	* @param fine std::shared_ptr<const AbstractScheme<>> - The fine propagator
+	* @param slices int - The number of the time slices
+	* @param maxIterations int - The maximum number of the Parareal iterations
+	* @param tolerance double - The iterations stop when the maximum change is below this value
+	* @param pool ThreadPool& - The pool executing the fine propagations (default value is the shared pool)
+	*/
+	PararealSolver(std::shared_ptr<const AbstractScheme<>> coarse, std::shared_ptr<const AbstractScheme<>> fine, int slices, int maxIterations, double tolerance, ThreadPool& pool = ThreadPool::shared());
+
+	/**
+	* Function that solves the problem until the given time frame
+	* It writes the convergence of every iteration and the wall-clock speedup against the serial fine solution to the streams
+	* @param initialFunction std::function< double(double) > - The initial values
+	* @param t double - The timeframe until the calculations should be executed
+	* @param stream std::ostream& - The stream to write the report to
+	* @param timingStream std::ostream* - The stream of the wall-clock times and the speedup, they differ between the runs
+	* (default value is nullptr, the report stream is used)
+	* @return std::vector<double> - The values on the fine grid at the given time frame
+	*/
+	std::vector<double> solve(std::function< double(double) > initialFunction, double t, std::ostream& stream, std::ostream* timingStream = nullptr);
+};
@@ -0,0 +1,39 @@
+#include <cmath>
+#include <sstream>
+#include "PeriodicFunction.h"
+
+PeriodicFunction::PeriodicFunction(std::shared_ptr<const BatchFunction> _function, double _start, double _end, double _velocity)
+	: function(_function), start(_start), end(_end), velocity(_velocity)
+{
+
+}
+
+void PeriodicFunction::evaluate(const double* x, double t, double* values, std::size_t count) const
+{
+	auto period = end - start, shift = velocity * t;
+
+	// The wrapped points are written to the values, the adapted function supports the same input and output array
+	for (std::size_t i = 0; i < count; i++) {
+		auto phase = x[i] - shift - start;
+
+		values[i] = start + (phase - period * std::floor(phase / period)) + shift;
+	}
+
+	function->evaluate(values, t, values, count);
+}
+
+std::string PeriodicFunction::getIdentity() const
+{
+	auto identity = function->getIdentity();
+
+	if (identity.empty()) {
+		return identity;
+	}
+
+	std::ostringstream periodic;
+
+	periodic.precision(17);
+	periodic << "periodic " << start << " " << end << " " << velocity << " " << identity;
+
+	return periodic.str();
+}
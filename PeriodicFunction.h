@@ -0,0 +1,35 @@
+#pragma once // Include guard
+
+#include <memory>
+#include "BatchFunction.h"
+
+/**
+* Batch function class of the periodic extension of a travelling wave
+* \nThe wave f(x, t) = f0(x - velocity * t) leaving the domain on one side enters it on the other side,
+* \nso the adapted function is evaluated at the point of the same phase wrapped into [start, end)
+*/
+class PeriodicFunction : public BatchFunction
+{
+	std::shared_ptr<const BatchFunction> function;
+	double start, end, velocity;
+
+public:
+	/**
+	* Constructor for the periodic extension
+	* @param function std::shared_ptr<const BatchFunction> - The travelling wave on the unbounded domain
+	* @param start double - Beginning of the period
+	* @param end double - End of the period
+	* @param velocity double - The velocity of the wave
+	*/
+	PeriodicFunction(std::shared_ptr<const BatchFunction> function, double start, double end, double velocity);
+
+	/**
+	* Override the pure virtual function to evaluate the wave at the wrapped points
+	*/
+	void evaluate(const double* x, double t, double* values, std::size_t count) const override;
+
+	/**
+	* Override the identity with the period and the identity of the wave (empty if the wave is unknown)
+	*/
+	std::string getIdentity() const override;
+};
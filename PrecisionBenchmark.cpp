@@ -0,0 +1,103 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include "PrecisionBenchmark.h"
+#include "ExplicitUpwindScheme.h"
+#include "ImplicitUpwindScheme.h"
+#include "LaxWendroffScheme.h"
+#include "RichtmyerScheme.h"
+#include "TVDScheme.h"
+#include "WENOScheme.h"
+#include "VectorNorms.h"
+#include "GaussianProfile.h"
+
+// The benchmark problem: Gaussian pulse on the usual domain with a stable Courant number
+static const double benchmarkStart = -50.0, benchmarkEnd = 50.0, benchmarkVelocity = 1.75, benchmarkCfl = 0.5;
+
+static const GaussianProfile gaussian(0.5, benchmarkVelocity);
+
+template <typename T>
+PrecisionBenchmark::Result PrecisionBenchmark::measure(AbstractScheme<T>& scheme, double t)
+{
+	typedef std::chrono::steady_clock clock;
+
+	auto spacePoints = scheme.getSpacePoints();
+
+	scheme.setFunction(std::make_shared<GaussianProfile>(gaussian), 0, 0);
+
+	auto initial = scheme.discretise(gaussian);
+	auto state = scheme.createState();
+	auto start = clock::now();
+	auto& values = scheme.propagate(*state, initial, t);
+	std::chrono::duration<double> elapsed = clock::now() - start;
+
+	// The errors are accumulated in double precision for both value types
+	std::vector<double> difference(values.size());
+
+	gaussian.evaluate(scheme.getGrid()->coordinates(), t, difference.data(), difference.size());
+
+	for (auto i = 0; i <= spacePoints; i++) {
+		difference[i] = std::fabs(difference[i] - static_cast<double>(values[i]));
+	}
+
+	Result result;
+	result.seconds = elapsed.count();
+	result.infinite = VectorNorms<double>::infiniteNorm(&difference);
+	result.first = VectorNorms<double>::pNorm(&difference, 1);
+	result.second = VectorNorms<double>::pNorm(&difference, 2);
+
+	return result;
+}
+
+void PrecisionBenchmark::writeResult(std::ostream& stream, std::string name, std::string type, const Result& result, long long cellUpdates)
+{
+	stream << name << ", " << type << ", " << result.seconds << "s, " << cellUpdates / result.seconds / 1e6 << " Mcells/s, " << result.seconds / cellUpdates * 1e9 << " ns/cell, "
+		<< "infinite " << result.infinite << ", 1st " << result.first << ", 2nd " << result.second << std::endl;
+}
+
+template <template <typename> class Scheme, typename... Args>
+void PrecisionBenchmark::compare(std::ostream& stream, int spacePoints, double t, Args... args)
+{
+	Scheme<float> single(benchmarkStart, benchmarkEnd, t, spacePoints, benchmarkVelocity, benchmarkCfl, args...);
+	Scheme<double> full(benchmarkStart, benchmarkEnd, t, spacePoints, benchmarkVelocity, benchmarkCfl, args...);
+
+	auto deltaT = benchmarkCfl * (benchmarkEnd - benchmarkStart) / spacePoints / benchmarkVelocity;
+	auto cellUpdates = (long long)std::ceil(t / deltaT - 1e-9) * (spacePoints - 1);
+	auto fullResult = measure(full, t);
+	auto singleResult = measure(single, t);
+
+	writeResult(stream, full.getName(), "double", fullResult, cellUpdates);
+	writeResult(stream, single.getName(), "float", singleResult, cellUpdates);
+	stream << "float speedup is " << fullResult.seconds / singleResult.seconds << ", 2nd norm error cost is " << singleResult.second - fullResult.second << std::endl << std::endl;
+}
+
+void PrecisionBenchmark::run(std::ostream& stream, int spacePoints, double t)
+{
+	stream << "\n-----------------------\nPrecision benchmark\n-----------------------\n\n";
+
+	compare<ExplicitUpwindScheme>(stream, spacePoints, t);
+	compare<LaxWendroffScheme>(stream, spacePoints, t);
+	compare<RichtmyerScheme>(stream, spacePoints, t);
+	compare<TVDScheme>(stream, spacePoints, t, FluxLimiter::VanLeer);
+	compare<WENOScheme>(stream, spacePoints, t);
+
+	// Dense LU decomposition, only small grids are feasible
+	auto implicitPoints = std::min(spacePoints, 400);
+	auto deltaT = benchmarkCfl * (benchmarkEnd - benchmarkStart) / implicitPoints / benchmarkVelocity;
+	auto cellUpdates = (long long)std::ceil(t / deltaT - 1e-9) * (implicitPoints - 1);
+
+	ImplicitUpwindScheme<double> full(benchmarkStart, benchmarkEnd, t, implicitPoints, benchmarkVelocity, benchmarkCfl);
+	ImplicitUpwindScheme<double> mixed(benchmarkStart, benchmarkEnd, t, implicitPoints, benchmarkVelocity, benchmarkCfl);
+	ImplicitUpwindScheme<float> single(benchmarkStart, benchmarkEnd, t, implicitPoints, benchmarkVelocity, benchmarkCfl);
+	mixed.setMixedPrecision(true);
+
+	auto fullResult = measure(full, t);
+	auto mixedResult = measure(mixed, t);
+	auto singleResult = measure(single, t);
+
+	writeResult(stream, full.getName(), "double", fullResult, cellUpdates);
+	writeResult(stream, mixed.getName(), "mixed", mixedResult, cellUpdates);
+	writeResult(stream, single.getName(), "float", singleResult, cellUpdates);
+	stream << "mixed speedup is " << fullResult.seconds / mixedResult.seconds << ", 2nd norm error cost is " << mixedResult.second - fullResult.second << std::endl;
+	stream << "float speedup is " << fullResult.seconds / singleResult.seconds << ", 2nd norm error cost is " << singleResult.second - fullResult.second << std::endl << std::endl;
+}
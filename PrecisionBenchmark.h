@@ -0,0 +1,66 @@
+#pragma once // Include guard
+
+#include <functional>
+#include <ostream>
+#include <string>
+#include "AbstractScheme.h"
+
+/**
+* Static class for comparing the single and double precision instantiations of the schemes
+* The Gaussian pulse is advected with every scheme, the wall-clock time, the throughput,
+* the cost of a cell update and the error norms are written for both value types
+* \nThe timings differ between the runs, so the benchmark is only run by the --benchmark option of the interactive mode
+*
+* The PrecisionBenchmark class provides:
+* \n-run function to benchmark all schemes on the given grid
+*/
+class PrecisionBenchmark
+{
+	/**
+	* The measured values of a single run
+	*/
+	struct Result
+	{
+		double seconds, infinite, first, second;
+	};
+
+	/**
+	* Private method that propagates the Gaussian pulse with a scheme and measures the time and the errors
+	* @param scheme AbstractScheme<T>& - The scheme to be measured
+	* @param t double - The timeframe until the calculations should be executed
+	* @return Result - The measured values
+	*/
+	template <typename T>
+	static Result measure(AbstractScheme<T>& scheme, double t);
+
+	/**
+	* Private method that benchmarks the float and double instantiations of a scheme
+	* @param stream std::ostream& - The stream to write the results to
+	* @param spacePoints int - The number of intervals in the space dimension
+	* @param t double - The timeframe until the calculations should be executed
+	* @param args Args - The scheme specific constructor parameters
+	*/
+	template <template <typename> class Scheme, typename... Args>
+	static void compare(std::ostream& stream, int spacePoints, double t, Args... args);
+
+	/**
+	* Private method that writes one line of the results
+	*/
+	static void writeResult(std::ostream& stream, std::string name, std::string type, const Result& result, long long cellUpdates);
+
+public:
+	// Delete default member functions to emphasize that the class should only be used to access the static functions.
+	PrecisionBenchmark() = delete;
+	~PrecisionBenchmark() = delete;
+	PrecisionBenchmark(const PrecisionBenchmark& that) = delete;
+	PrecisionBenchmark & operator=(const PrecisionBenchmark&) = delete;
+
+	/**
+	* Static public method that benchmarks every scheme in single, double and (for the implicit scheme) mixed precision
+	* The implicit scheme uses dense matrices, so its grid is limited to 400 intervals
+	* @param stream std::ostream& - The stream to write the results to
+	* @param spacePoints int - The number of intervals in the space dimension
+	* @param t double - The timeframe until the calculations should be executed
+	*/
+	static void run(std::ostream& stream, int spacePoints, double t);
+};
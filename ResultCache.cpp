@@ -0,0 +1,192 @@
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include "ResultCache.h"
+
+#ifdef _WIN32
+#include <direct.h>
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <sys/stat.h>
+#endif
+
+ResultCache::ResultCache(std::string _directory, std::uint64_t _maxBytes, std::string _version)
+	: directory(_directory), version(_version), maxBytes(_maxBytes), totalBytes(0), useCounter(0), hits(0), misses(0), stores(0), evictions(0), temporaryCounter(0)
+{
+#ifdef _WIN32
+	_mkdir(directory.c_str());
+#else
+	mkdir(directory.c_str(), 0755);
+#endif
+
+	// Every line of the index is the hash, the size and the last use of an entry
+	std::ifstream index(directory + "/index.txt");
+	std::string name;
+	Entry entry;
+
+	while (index >> name >> entry.size >> entry.lastUse) {
+		entries[name] = entry;
+		totalBytes += entry.size;
+		useCounter = std::max(useCounter, entry.lastUse + 1);
+	}
+}
+
+ResultCache::~ResultCache()
+{
+	std::lock_guard<std::mutex> lock(mutex);
+
+	saveIndex();
+}
+
+std::string ResultCache::hash(const std::string& key)
+{
+	std::uint64_t value = 14695981039346656037ULL;
+
+	for (auto character : key) {
+		value = (value ^ (unsigned char)character) * 1099511628211ULL;
+	}
+
+	char text[17];
+	snprintf(text, sizeof(text), "%016llx", (unsigned long long)value);
+
+	return text;
+}
+
+std::string ResultCache::buildVersion()
+{
+#ifdef _WIN32
+	char path[MAX_PATH];
+	auto length = GetModuleFileNameA(nullptr, path, MAX_PATH);
+	std::ifstream file(std::string(path, length), std::ios_base::binary);
+#else
+	std::ifstream file("/proc/self/exe", std::ios_base::binary);
+#endif
+	std::string executable((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+	return executable.empty() ? std::string(__DATE__ " " __TIME__) : hash(executable);
+}
+
+bool ResultCache::writeAtomic(const std::string& path, const std::string& content)
+{
+	auto temporary = path + ".tmp" + std::to_string(temporaryCounter++);
+
+	{
+		std::ofstream file(temporary, std::ios_base::binary | std::ios_base::trunc);
+
+		if (!(file << content) || !file.flush()) {
+			file.close();
+			std::remove(temporary.c_str());
+			return false;
+		}
+	}
+
+	// The rename does not replace an existing file on Windows
+	if (std::rename(temporary.c_str(), path.c_str()) != 0) {
+		std::remove(path.c_str());
+
+		if (std::rename(temporary.c_str(), path.c_str()) != 0) {
+			std::remove(temporary.c_str());
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool ResultCache::load(const std::string& _key, std::string& content)
+{
+	auto key = version + "\n" + _key;
+	auto name = hash(key);
+
+	// The entry is the length of the key and the content, then the key and the content
+	std::ifstream file(directory + "/" + name + ".txt", std::ios_base::binary);
+	std::string stored((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+	std::istringstream header(stored);
+	std::size_t keySize = 0, contentSize = 0;
+
+	auto valid = file && (header >> keySize >> contentSize) && header.get() == '\n';
+	std::size_t offset = valid ? (std::size_t)header.tellg() : 0;
+
+	valid = valid && stored.size() == offset + keySize + contentSize && stored.compare(offset, keySize, key) == 0;
+
+	std::lock_guard<std::mutex> lock(mutex);
+
+	if (!valid) {
+		misses++;
+		return false;
+	}
+
+	content = stored.substr(offset + keySize);
+	hits++;
+
+	auto entry = entries.find(name);
+
+	if (entry != entries.end()) {
+		entry->second.lastUse = useCounter++;
+	}
+
+	return true;
+}
+
+void ResultCache::store(const std::string& _key, const std::string& content)
+{
+	auto key = version + "\n" + _key;
+	auto name = hash(key);
+	auto entryContent = std::to_string(key.size()) + " " + std::to_string(content.size()) + "\n" + key + content;
+
+	if (!writeAtomic(directory + "/" + name + ".txt", entryContent)) {
+		return;
+	}
+
+	std::lock_guard<std::mutex> lock(mutex);
+
+	auto& entry = entries[name];
+
+	totalBytes += entryContent.size() - entry.size;
+	entry.size = entryContent.size();
+	entry.lastUse = useCounter++;
+	stores++;
+
+	evict();
+	saveIndex();
+}
+
+void ResultCache::evict()
+{
+	while (totalBytes > maxBytes && !entries.empty()) {
+		auto oldest = entries.begin();
+
+		for (auto entry = entries.begin(); entry != entries.end(); entry++) {
+			if (entry->second.lastUse < oldest->second.lastUse) {
+				oldest = entry;
+			}
+		}
+
+		std::remove((directory + "/" + oldest->first + ".txt").c_str());
+		totalBytes -= oldest->second.size;
+		entries.erase(oldest);
+		evictions++;
+	}
+}
+
+void ResultCache::saveIndex()
+{
+	std::ostringstream index;
+
+	for (auto& entry : entries) {
+		index << entry.first << " " << entry.second.size << " " << entry.second.lastUse << "\n";
+	}
+
+	writeAtomic(directory + "/index.txt", index.str());
+}
+
+void ResultCache::writeStats(std::ostream& stream) const
+{
+	std::lock_guard<std::mutex> lock(mutex);
+
+	stream << "Result cache: " << hits << " hits, " << misses << " misses, " << stores << " stores, " << evictions << " evictions, "
+		<< entries.size() << " entries of " << totalBytes << " bytes (cap " << maxBytes << " bytes)" << std::endl;
+}
@@ -0,0 +1,106 @@
+#pragma once // Include guard
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <string>
+
+/**
+* Content-addressed store of the result files
+* \nThe results are keyed by the description of the run (scheme, parameters, initial function) and the build version,
+* \nthe file names are the 64-bit FNV-1a hashes of the keys. Every entry starts with its full key and size,
+* \nso hash collisions and incomplete files are detected and treated as misses.
+* \nThe entries are written to a temporary file and renamed, the least recently used entries are evicted
+* \nwhen the total size exceeds the cap. The sizes and the last uses are kept in the index file of the directory.
+* \nThe functions can be called concurrently.
+*
+* The ResultCache class provides:
+* \n-load function to retrieve a cached result
+* \n-store function to add a result
+* \n-writeStats function to report the hits, misses and evictions
+* \n-buildVersion function to identify the running executable
+*/
+class ResultCache
+{
+	/**
+	* The size and the last use of an entry
+	*/
+	struct Entry
+	{
+		std::uint64_t size, lastUse;
+	};
+
+	std::string directory, version;
+	std::uint64_t maxBytes, totalBytes, useCounter;
+	std::map<std::string, Entry> entries;
+	long long hits, misses, stores, evictions;
+	std::atomic<unsigned> temporaryCounter;
+	mutable std::mutex mutex;
+
+	/**
+	* Private method that returns the FNV-1a hash of the key as a hexadecimal string
+	*/
+	static std::string hash(const std::string& key);
+
+	/**
+	* Private method that writes a file with a temporary name, then renames it
+	*/
+	bool writeAtomic(const std::string& path, const std::string& content);
+
+	/**
+	* Private method that removes the least recently used entries until the size is below the cap, the mutex must be locked
+	*/
+	void evict();
+
+	/**
+	* Private method that writes the index file, the mutex must be locked
+	*/
+	void saveIndex();
+
+public:
+	/**
+	* Constructor for the cache, the directory is created if it does not exist and the index is loaded
+	* @param directory std::string - The directory of the entries
+	* @param maxBytes std::uint64_t - The size cap of the entries
+	* @param version std::string - The build version, the entries of other builds are not used
+	*/
+	ResultCache(std::string directory, std::uint64_t maxBytes, std::string version);
+
+	/**
+	* Destructor that writes the last uses to the index
+	*/
+	~ResultCache();
+
+	ResultCache(const ResultCache& that) = delete;
+	ResultCache & operator=(const ResultCache&) = delete;
+
+	/**
+	* Static public method that returns the hash of the running executable, so every build invalidates the cache
+	* If the executable cannot be read, the compilation time of this file is used
+	* @return std::string - The version of the build
+	*/
+	static std::string buildVersion();
+
+	/**
+	* Function that retrieves a cached result
+	* @param key std::string - The description of the run
+	* @param content std::string& - The cached result
+	* @return bool - True on a hit, false if the result is missing or invalid
+	*/
+	bool load(const std::string& key, std::string& content);
+
+	/**
+	* Function that adds a result and evicts the least recently used entries above the size cap
+	* @param key std::string - The description of the run
+	* @param content std::string - The result
+	*/
+	void store(const std::string& key, const std::string& content);
+
+	/**
+	* Function that writes the number of the hits, misses, stores and evictions and the size of the cache
+	* @param stream std::ostream& - The stream to write the statistics to
+	*/
+	void writeStats(std::ostream& stream) const;
+};
@@ -1,32 +1,56 @@
 #include <iostream>
 #include "RichtmyerScheme.h"
 
-RichtmyerScheme::RichtmyerScheme(double xStart, double xEnd, double t, int spacePoints, double u, double cfl, std::ostream& stream)
-	: AbstractScheme(stream, "Richtmyer Scheme", xStart, xEnd, t, spacePoints, u, cfl)
+template <typename T>
+RichtmyerScheme<T>::RichtmyerScheme(double xStart, double xEnd, double t, int spacePoints, double u, double cfl)
+	: FluxFormScheme<T>("Richtmyer Scheme", xStart, xEnd, t, spacePoints, u, cfl)
 {
 
 }
 
-// Define the pure virtual function of the base class
-std::vector<double> RichtmyerScheme::calculateIteration(double t)
+template <typename T>
+int RichtmyerScheme<T>::stencilRadius() const
 {
-	std::vector<double> newValues;
-	double prev, next;
+	return 2;
+}
 
-	newValues.push_back(left);
-	newValues.push_back(left);
+template <typename T>
+std::unique_ptr<SimulationState<T>> RichtmyerScheme<T>::allocateState() const
+{
+	return std::unique_ptr<SimulationState<T>>(new State());
+}
 
-	for (auto i = 2; i < spacePoints - 1; i++) {
-		next = 0.5 * (currentValues[i + 2] + currentValues[i]) - (u * deltaT / (4 * deltaX) * (currentValues[i + 2] - currentValues[i]));
-		prev = 0.5 * (currentValues[i] + currentValues[i - 2]) - (u * deltaT / (4 * deltaX) * (currentValues[i] - currentValues[i - 2]));
+// Define the pure virtual function of the base class
+template <typename T>
+void RichtmyerScheme<T>::calculateFluxes(typename FluxFormScheme<T>::State& state, int first, int last) const
+{
+	auto& q = state.currentValues;
+	auto& fluxes = state.fluxes;
+	auto& halfStep = static_cast<State&>(state).halfStep;
+	auto halfU = static_cast<T>(this->u * 0.5);
+	auto quarterNu = static_cast<T>(this->u * state.deltaT / (4 * state.deltaX));
+	auto half = static_cast<T>(0.5);
+
+	halfStep.resize(state.spacePoints + 1);
+
+	// Every intermediate value is calculated only once
+	for (auto i = first; i <= last + 1; i++) {
+		halfStep[i] = half * (q[i + 1] + q[i - 1]) - (quarterNu * (q[i + 1] - q[i - 1]));
+	}
 
-		newValues.push_back(currentValues[i] - u * deltaT / (2 * deltaX) * (next - prev));
+	for (auto i = first; i <= last; i++) {
+		fluxes[i] = halfU * (halfStep[i] + halfStep[i + 1]);
 	}
+}
 
-	newValues.push_back(right);
-	newValues.push_back(right);
+template <typename T>
+std::vector<Stencil> RichtmyerScheme<T>::getStencils(double cfl) const
+{
+	auto half = 0.5 * cfl;
 
-	currentValues = newValues;
+	return { Stencil{ -2, { 0.5 * half * (1 + half), 0, 1 - half * half, 0, -0.5 * half * (1 - half) }, {} } };
+}
 
-	return currentValues;
-}
\ No newline at end of file
+// Explicit instantiation for the supported value types
+template class RichtmyerScheme<float>;
+template class RichtmyerScheme<double>;
@@ -1,13 +1,43 @@
 #pragma once // Include guard
 
-#include "AbstractScheme.h"
+#include "FluxFormScheme.h"
 
 /**
-* Richtmyer scheme class derived from the Abstract scheme
-* It overrides the default implementation of the approximator function
+* Richtmyer scheme class derived from the Flux-form scheme
+* It overrides the default implementation of the flux function
+* \nThe intermediate half-step values are calculated once per time step and shared by the neighbouring fluxes
 */
-class RichtmyerScheme : public AbstractScheme
+template <typename T = double>
+class RichtmyerScheme : public FluxFormScheme<T>
 {
+protected:
+	/**
+	* The state of a run of the Richtmyer scheme with the buffer of the intermediate half-step values
+	*/
+	class State : public FluxFormScheme<T>::State
+	{
+	public:
+		std::vector<T> halfStep;
+	};
+
+	/**
+	* Override the state allocation to provide the half-step buffer
+	* @return std::unique_ptr<SimulationState<T>> - The new state
+	*/
+	std::unique_ptr<SimulationState<T>> allocateState() const override;
+
+	/**
+	* Override the pure virtual function to calculate the Richtmyer fluxes
+	* F(i+1/2) = u * 0.5 * (h(i) + h(i+1)), where h are the intermediate half-step values
+	*/
+	void calculateFluxes(typename FluxFormScheme<T>::State& state, int first, int last) const override;
+
+	/**
+	* The Richtmyer scheme uses the i-2 ... i+2 cells
+	* @return int - The radius of the stencil
+	*/
+	int stencilRadius() const override;
+
 public:
 	/**
 	* Constructor for the Richtmyer scheme
@@ -16,16 +46,12 @@ public:
 	* @param t double - The timeframe until the calculations should be executed
 	* @param spacePoints int - The number of intervals in the space dimension
 	* @param u double - The velocity of the wave
-	* @param file std::ostream& - The stream to write the results to (default value is std::cout)
 	*/
-	RichtmyerScheme(double xStart, double xEnd, double t, int spacePoints, double u, double cfl, std::ostream& stream);
-	
+	RichtmyerScheme(double xStart, double xEnd, double t, int spacePoints, double u, double cfl);
+
 	/**
-	* Override the pure virtual function to approximate using the Richtmyer scheme
-	* It returns a vector of doubles containing the numerical values
-	* @param double t - The current time frame
-	* @return std::vector<double> - The calculated numerical values
+	* Override the stencils, the half step values use the i-1 and i+1 cells,
+	* so the scheme is the Lax-Wendroff scheme with cfl / 2 on the every second cells
 	*/
-	std::vector<double> calculateIteration(double t) override;
+	std::vector<Stencil> getStencils(double cfl) const override;
 };
-
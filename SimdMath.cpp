@@ -0,0 +1,7 @@
+#include "SimdMath.h"
+#include "Kernels.h"
+
+void SimdMath::exp(const double* x, double* result, std::size_t count)
+{
+	Kernels::get<double>().exp(x, result, count);
+}
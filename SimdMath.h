@@ -0,0 +1,30 @@
+#pragma once // Include guard
+
+#include <cstddef>
+
+/**
+* Static class for the elementary functions evaluated on whole arrays
+* The functions run the dispatched kernels (Kernels), so the values are processed
+* \nin the widest registers of the processor and every variant gives the same results
+*
+* The SimdMath class provides:
+* \n-exp function to calculate the exponential of every element of an array
+*/
+class SimdMath
+{
+public:
+	// Delete default member functions to emphasize that the class should only be used to access the static functions.
+	SimdMath() = delete;
+	~SimdMath() = delete;
+	SimdMath(const SimdMath& that) = delete;
+	SimdMath & operator=(const SimdMath&) = delete;
+
+	/**
+	* Static public method that calculates the exponential of the elements
+	* The relative error is below 1e-15, the results underflow, overflow and propagate NaN like the ones of std::exp
+	* @param x const double* - The arguments
+	* @param result double* - The calculated values (may be the same array as x)
+	* @param count std::size_t - The number of the elements
+	*/
+	static void exp(const double* x, double* result, std::size_t count);
+};
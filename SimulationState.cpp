@@ -0,0 +1,18 @@
+#include "SimulationState.h"
+
+template <typename T>
+SimulationState<T>::SimulationState()
+	: spacePoints(0), timeSteps(0), t(0), cfl(0), deltaX(0), deltaT(0), activeFirst(0), activeLast(-1)
+{
+
+}
+
+template <typename T>
+SimulationState<T>::~SimulationState()
+{
+
+}
+
+// Explicit instantiation for the supported value types
+template class SimulationState<float>;
+template class SimulationState<double>;
@@ -0,0 +1,54 @@
+#pragma once // Include guard
+
+#include <memory>
+#include <vector>
+#include "Grid.h"
+#include "MonotonicArena.h"
+
+/**
+* Class holding the mutable data of a single run of a scheme
+* \nThe schemes are immutable descriptions of the method, every run gets its own state,
+* \nso one scheme instance can drive many concurrent runs. The schemes with own per-run data
+* \n(fluxes, factorised matrices, refined patches) derive their state from this class.
+*
+* The state of the scheme is stored with the T value type (float or double, default value is double)
+*/
+template <typename T = double>
+class SimulationState
+{
+public:
+	/**
+	* The grid, the number of intervals and the time steps of the run
+	*/
+	std::shared_ptr<const Grid> grid;
+
+	/**
+	* The arena of the per-run containers (matrices, scratch buffers, the analytical values and the errors of the evaluation),
+	* it is released in one shot with the state
+	* \nThe schemes release it when they prepare a new run on the same state, after dropping their containers
+	*/
+	MonotonicArena arena;
+	int spacePoints, timeSteps;
+	double t, cfl, deltaX, deltaT;
+
+	/**
+	* The values of the current and the next time step (double buffering)
+	*/
+	std::vector<T> currentValues, nextValues;
+
+	/**
+	* The first and last cells which can change in the current time step
+	* \nOutside of this region the values are constant, so the explicit schemes skip these cells
+	*/
+	int activeFirst, activeLast;
+
+	/**
+	* Constructor for an empty state, the schemes fill it in their createState function
+	*/
+	SimulationState();
+
+	/**
+	* Virtual destructor to allow the deletion of derived classes through a pointer to the base class
+	*/
+	virtual ~SimulationState();
+};
@@ -0,0 +1,143 @@
+#include <stdexcept>
+#include "SnapshotCodec.h"
+
+const unsigned char SnapshotCodec::zeroRun;
+const std::uint64_t SnapshotCodec::headerMagic;
+const std::uint64_t SnapshotCodec::indexMagic;
+
+void SnapshotCodec::pack(const std::uint64_t* residuals, std::size_t count, std::vector<unsigned char>& buffer)
+{
+	for (std::size_t i = 0; i < count;) {
+		auto value = residuals[i];
+
+		if (value == 0) {
+			std::size_t run = 0;
+
+			while (i < count && residuals[i] == 0) {
+				run++;
+				i++;
+			}
+
+			// The length of the run is a variable length integer, 7 bits per byte
+			buffer.push_back(zeroRun);
+
+			while (run >= 0x80) {
+				buffer.push_back((unsigned char)(run | 0x80));
+				run >>= 7;
+			}
+
+			buffer.push_back((unsigned char)run);
+			continue;
+		}
+
+		auto leading = 0, trailing = 0;
+
+		while ((value >> (56 - 8 * leading)) == 0) {
+			leading++;
+		}
+
+		while (((value >> (8 * trailing)) & 0xFF) == 0) {
+			trailing++;
+		}
+
+		buffer.push_back((unsigned char)((leading << 4) | trailing));
+
+		for (auto byte = trailing; byte < 8 - leading; byte++) {
+			buffer.push_back((unsigned char)(value >> (8 * byte)));
+		}
+
+		i++;
+	}
+}
+
+void SnapshotCodec::unpack(const unsigned char* data, std::size_t size, std::uint64_t* residuals, std::size_t count)
+{
+	std::size_t position = 0, i = 0;
+
+	while (i < count) {
+		if (position >= size) {
+			throw std::runtime_error("the snapshot data is corrupted");
+		}
+
+		auto header = data[position++];
+
+		if (header == zeroRun) {
+			std::size_t run = 0;
+
+			for (auto shift = 0; ; shift += 7) {
+				if (position >= size || shift > 63) {
+					throw std::runtime_error("the snapshot data is corrupted");
+				}
+
+				run |= (std::size_t)(data[position] & 0x7F) << shift;
+
+				if ((data[position++] & 0x80) == 0) {
+					break;
+				}
+			}
+
+			if (run > count - i) {
+				throw std::runtime_error("the snapshot data is corrupted");
+			}
+
+			for (; run > 0; run--) {
+				residuals[i++] = 0;
+			}
+
+			continue;
+		}
+
+		auto leading = header >> 4, trailing = header & 0x0F;
+
+		if (leading + trailing > 7 || position + (8 - leading - trailing) > size) {
+			throw std::runtime_error("the snapshot data is corrupted");
+		}
+
+		std::uint64_t value = 0;
+
+		for (auto byte = trailing; byte < 8 - leading; byte++) {
+			value |= (std::uint64_t)data[position++] << (8 * byte);
+		}
+
+		residuals[i++] = value;
+	}
+
+	if (position != size) {
+		throw std::runtime_error("the snapshot data is corrupted");
+	}
+}
+
+void SnapshotCodec::residual(const std::uint64_t* words, const std::uint64_t* previous, std::uint64_t* residuals, std::size_t count, bool lossy)
+{
+	for (std::size_t i = 0; i < count; i++) {
+		auto prediction = previous != nullptr ? previous[i] : 0;
+
+		if (lossy) {
+			// Zigzag encoding, the small negative differences also have leading zero bytes
+			auto difference = (std::int64_t)(words[i] - prediction);
+
+			residuals[i] = ((std::uint64_t)difference << 1) ^ (std::uint64_t)(difference >> 63);
+		}
+		else
+		{
+			residuals[i] = words[i] ^ prediction;
+		}
+	}
+}
+
+void SnapshotCodec::reconstruct(std::uint64_t* residuals, const std::uint64_t* previous, std::size_t count, bool lossy)
+{
+	for (std::size_t i = 0; i < count; i++) {
+		auto prediction = previous != nullptr ? previous[i] : 0;
+
+		if (lossy) {
+			auto difference = (residuals[i] >> 1) ^ (0 - (residuals[i] & 1));
+
+			residuals[i] = prediction + difference;
+		}
+		else
+		{
+			residuals[i] ^= prediction;
+		}
+	}
+}
@@ -0,0 +1,76 @@
+#pragma once // Include guard
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+* Static class of the lossless codec of the snapshot files
+* \nThe values of a time level are predicted from the previous level (delta encoding), the codec packs the 64-bit residuals:
+* \n-the runs of zero residuals (unchanged values) are stored as a marker byte and the length of the run
+* \n-the other residuals are stored as a header byte with the number of their leading and trailing zero bytes,
+* \nfollowed by the remaining bytes, so the small and the float-like residuals take only a few bytes
+*
+* The SnapshotCodec class provides:
+* \n-pack and unpack functions to encode and decode the residuals of a time level
+* \n-residual and reconstruct functions to calculate the residuals of the lossless (XOR) and the lossy (quantised) modes
+*/
+class SnapshotCodec
+{
+	/**
+	* The header byte of a run of zero residuals
+	*/
+	static const unsigned char zeroRun = 0xFF;
+
+public:
+	/**
+	* The magic numbers of the snapshot files ("CMSNAP01" and "CMSNAPIX" in little endian byte order)
+	*/
+	static const std::uint64_t headerMagic = 0x313050414E534D43ULL;
+	static const std::uint64_t indexMagic = 0x584950414E534D43ULL;
+
+	// Delete default member functions to emphasize that the class should only be used to access the static functions.
+	SnapshotCodec() = delete;
+	~SnapshotCodec() = delete;
+	SnapshotCodec(const SnapshotCodec& that) = delete;
+	SnapshotCodec & operator=(const SnapshotCodec&) = delete;
+
+	/**
+	* Static public method that appends the packed residuals to the buffer
+	* @param residuals const std::uint64_t* - The residuals
+	* @param count std::size_t - The number of the residuals
+	* @param buffer std::vector<unsigned char>& - The buffer to append to
+	*/
+	static void pack(const std::uint64_t* residuals, std::size_t count, std::vector<unsigned char>& buffer);
+
+	/**
+	* Static public method that unpacks the residuals
+	* Throws std::runtime_error if the data is corrupted
+	* @param data const unsigned char* - The packed residuals
+	* @param size std::size_t - The size of the packed data
+	* @param residuals std::uint64_t* - The unpacked residuals
+	* @param count std::size_t - The number of the residuals
+	*/
+	static void unpack(const unsigned char* data, std::size_t size, std::uint64_t* residuals, std::size_t count);
+
+	/**
+	* Static public methods that calculate the residuals of a time level from the words of the current and the previous level
+	* In the lossless mode the words are the bit patterns of the values and the residual is their XOR,
+	* in the lossy mode the words are the quantised values and the residual is their zigzag encoded difference
+	* @param words const std::uint64_t* - The words of the current level
+	* @param previous const std::uint64_t* - The words of the previous level, nullptr for a keyframe
+	* @param residuals std::uint64_t* - The calculated residuals
+	* @param count std::size_t - The number of the values
+	* @param lossy bool - The mode of the residuals
+	*/
+	static void residual(const std::uint64_t* words, const std::uint64_t* previous, std::uint64_t* residuals, std::size_t count, bool lossy);
+
+	/**
+	* Static public method that is the inverse of the residual function, the words are calculated in place
+	* @param residuals std::uint64_t* - The residuals, they are overwritten with the words of the level
+	* @param previous const std::uint64_t* - The words of the previous level, nullptr for a keyframe
+	* @param count std::size_t - The number of the values
+	* @param lossy bool - The mode of the residuals
+	*/
+	static void reconstruct(std::uint64_t* residuals, const std::uint64_t* previous, std::size_t count, bool lossy);
+};
@@ -0,0 +1,128 @@
+#include <cstring>
+#include <stdexcept>
+#include "SnapshotReader.h"
+#include "SnapshotCodec.h"
+
+// Seek with a 64-bit offset, the files of the long runs are larger than the range of long
+static bool seek(std::FILE* file, long long offset, int origin)
+{
+#ifdef _WIN32
+	return _fseeki64(file, offset, origin) == 0;
+#else
+	return fseeko(file, (off_t)offset, origin) == 0;
+#endif
+}
+
+SnapshotReader::SnapshotReader(const std::string& path)
+	: file(std::fopen(path.c_str(), "rb")), points(0), tolerance(0), keyframeInterval(1), decodedLevel(-1)
+{
+	if (file == nullptr) {
+		throw std::runtime_error("the snapshot file " + path + " cannot be opened");
+	}
+
+	std::uint64_t magic = 0, count = 0, indexOffset = 0, indexMagic = 0;
+	std::uint32_t interval = 0, reserved = 0;
+
+	auto valid = std::fread(&magic, sizeof(magic), 1, file) == 1 && std::fread(&points, sizeof(points), 1, file) == 1 &&
+		std::fread(&tolerance, sizeof(tolerance), 1, file) == 1 && std::fread(&interval, sizeof(interval), 1, file) == 1 &&
+		std::fread(&reserved, sizeof(reserved), 1, file) == 1 && magic == SnapshotCodec::headerMagic && interval > 0;
+
+	// The footer is the number of the levels, the offset of the index and the index magic
+	valid = valid && seek(file, -(long long)(3 * sizeof(std::uint64_t)), SEEK_END) &&
+		std::fread(&count, sizeof(count), 1, file) == 1 && std::fread(&indexOffset, sizeof(indexOffset), 1, file) == 1 &&
+		std::fread(&indexMagic, sizeof(indexMagic), 1, file) == 1 && indexMagic == SnapshotCodec::indexMagic;
+
+	// The index and the levels are addressed with 64-bit offsets
+	valid = valid && indexOffset <= 0x7FFFFFFFFFFFFFFFull && seek(file, (long long)indexOffset, SEEK_SET);
+
+	for (std::uint64_t i = 0; valid && i < count; i++) {
+		Level level;
+
+		valid = std::fread(&level.time, sizeof(level.time), 1, file) == 1 && std::fread(&level.offset, sizeof(level.offset), 1, file) == 1 &&
+			std::fread(&level.size, sizeof(level.size), 1, file) == 1;
+
+		levels.push_back(level);
+	}
+
+	if (!valid) {
+		std::fclose(file);
+		throw std::runtime_error(path + " is not a snapshot file");
+	}
+
+	keyframeInterval = interval;
+	words.resize(points);
+}
+
+SnapshotReader::~SnapshotReader()
+{
+	std::fclose(file);
+}
+
+void SnapshotReader::decode(std::size_t level)
+{
+	auto& entry = levels[level];
+	auto keyframe = level % keyframeInterval == 0;
+
+	buffer.resize(entry.size);
+
+	if (!seek(file, (long long)entry.offset, SEEK_SET) || std::fread(buffer.data(), 1, buffer.size(), file) != buffer.size()) {
+		throw std::runtime_error("the snapshot cannot be read");
+	}
+
+	// The residuals are unpacked next to the previous level, then the words are reconstructed in place
+	std::vector<std::uint64_t> residuals(points);
+
+	SnapshotCodec::unpack(buffer.data(), buffer.size(), residuals.data(), points);
+	SnapshotCodec::reconstruct(residuals.data(), keyframe ? nullptr : words.data(), points, tolerance > 0);
+
+	words.swap(residuals);
+	decodedLevel = level;
+}
+
+std::vector<double> SnapshotReader::read(std::size_t level)
+{
+	if (level >= levels.size()) {
+		throw std::out_of_range("the snapshot level does not exist");
+	}
+
+	auto keyframe = (long long)(level - level % keyframeInterval);
+	auto first = decodedLevel >= keyframe && decodedLevel <= (long long)level ? decodedLevel + 1 : keyframe;
+
+	for (auto i = first; i <= (long long)level; i++) {
+		decode((std::size_t)i);
+	}
+
+	std::vector<double> values(points);
+
+	if (tolerance > 0) {
+		for (std::uint64_t i = 0; i < points; i++) {
+			values[i] = (double)(std::int64_t)words[i] * (2 * tolerance);
+		}
+	}
+	else
+	{
+		std::memcpy(values.data(), words.data(), points * sizeof(double));
+	}
+
+	return values;
+}
+
+std::size_t SnapshotReader::getLevels() const
+{
+	return levels.size();
+}
+
+std::size_t SnapshotReader::getPoints() const
+{
+	return points;
+}
+
+double SnapshotReader::getTime(std::size_t level) const
+{
+	return levels.at(level).time;
+}
+
+double SnapshotReader::getTolerance() const
+{
+	return tolerance;
+}
@@ -0,0 +1,90 @@
+#pragma once // Include guard
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+/**
+* Random access reader of the snapshot files written by the SnapshotWriter
+* \nA level is decoded from the preceding keyframe, the last decoded level is kept,
+* \nso reading the levels in order decodes every level only once.
+*
+* The SnapshotReader class provides:
+* \n-read function to decode a time level
+* \n-getLevels, getPoints, getTime and getTolerance functions to access the index and the header
+*/
+class SnapshotReader
+{
+	/**
+	* The index entry of a time level
+	*/
+	struct Level
+	{
+		double time;
+		std::uint64_t offset, size;
+	};
+
+	std::FILE* file;
+	std::uint64_t points;
+	double tolerance;
+	int keyframeInterval;
+	std::vector<Level> levels;
+	std::vector<std::uint64_t> words;
+	std::vector<unsigned char> buffer;
+	long long decodedLevel;
+
+	/**
+	* Private method that decodes the next level into the words, the words hold the previous level
+	*/
+	void decode(std::size_t level);
+
+public:
+	/**
+	* Constructor that opens the file and reads its header and index
+	* Throws std::runtime_error if the file cannot be opened or it is not a snapshot file
+	* @param path std::string - The path of the file
+	*/
+	SnapshotReader(const std::string& path);
+
+	/**
+	* Destructor that closes the file
+	*/
+	~SnapshotReader();
+
+	SnapshotReader(const SnapshotReader& that) = delete;
+	SnapshotReader & operator=(const SnapshotReader&) = delete;
+
+	/**
+	* Function that decodes a time level
+	* Throws std::out_of_range for invalid levels, std::runtime_error for corrupted data
+	* @param level std::size_t - The index of the level
+	* @return std::vector<double> - The values of the level
+	*/
+	std::vector<double> read(std::size_t level);
+
+	/**
+	* Function that returns the number of the levels
+	* @return std::size_t - The number of the levels
+	*/
+	std::size_t getLevels() const;
+
+	/**
+	* Function that returns the number of the values of every level
+	* @return std::size_t - The number of the values
+	*/
+	std::size_t getPoints() const;
+
+	/**
+	* Function that returns the time of a level
+	* @param level std::size_t - The index of the level
+	* @return double - The time of the level
+	*/
+	double getTime(std::size_t level) const;
+
+	/**
+	* Function that returns the maximum error of the values
+	* @return double - The tolerance of the lossy mode, 0 if the file is lossless
+	*/
+	double getTolerance() const;
+};
@@ -0,0 +1,107 @@
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+#include "SnapshotWriter.h"
+#include "SnapshotCodec.h"
+
+SnapshotWriter::SnapshotWriter(const std::string& path, std::size_t _points, double _tolerance, int _keyframeInterval)
+	: file(std::fopen(path.c_str(), "wb")), points(_points), tolerance(std::max(_tolerance, 0.0)), keyframeInterval(std::max(_keyframeInterval, 1)),
+	previous(_points), words(_points), residuals(_points), offset(0)
+{
+	if (file == nullptr) {
+		throw std::runtime_error("the snapshot file " + path + " cannot be created");
+	}
+
+	std::uint64_t magic = SnapshotCodec::headerMagic;
+	std::uint32_t interval = keyframeInterval, reserved = 0;
+
+	std::fwrite(&magic, sizeof(magic), 1, file);
+	std::fwrite(&points, sizeof(points), 1, file);
+	std::fwrite(&tolerance, sizeof(tolerance), 1, file);
+	std::fwrite(&interval, sizeof(interval), 1, file);
+	std::fwrite(&reserved, sizeof(reserved), 1, file);
+
+	offset = sizeof(magic) + sizeof(points) + sizeof(tolerance) + sizeof(interval) + sizeof(reserved);
+}
+
+SnapshotWriter::~SnapshotWriter()
+{
+	if (file != nullptr) {
+		close();
+	}
+}
+
+void SnapshotWriter::write(double time, const double* values)
+{
+	auto lossy = tolerance > 0;
+
+	if (lossy) {
+		auto step = 2 * tolerance;
+
+		for (std::uint64_t i = 0; i < points; i++) {
+			auto quantised = std::round(values[i] / step);
+
+			if (!(std::fabs(quantised) < 4e18)) {
+				throw std::invalid_argument("the value cannot be quantised with the tolerance of the snapshots");
+			}
+
+			words[i] = (std::uint64_t)(std::int64_t)quantised;
+		}
+	}
+	else
+	{
+		std::memcpy(words.data(), values, points * sizeof(double));
+	}
+
+	auto keyframe = levels.size() % keyframeInterval == 0;
+
+	SnapshotCodec::residual(words.data(), keyframe ? nullptr : previous.data(), residuals.data(), points, lossy);
+
+	buffer.clear();
+	SnapshotCodec::pack(residuals.data(), points, buffer);
+
+	if (std::fwrite(buffer.data(), 1, buffer.size(), file) != buffer.size()) {
+		throw std::runtime_error("the snapshot cannot be written");
+	}
+
+	levels.push_back(Level{ time, offset, buffer.size() });
+	offset += buffer.size();
+	previous.swap(words);
+}
+
+void SnapshotWriter::close()
+{
+	auto indexOffset = offset;
+	std::uint64_t count = levels.size(), magic = SnapshotCodec::indexMagic;
+
+	for (auto& level : levels) {
+		std::fwrite(&level.time, sizeof(level.time), 1, file);
+		std::fwrite(&level.offset, sizeof(level.offset), 1, file);
+		std::fwrite(&level.size, sizeof(level.size), 1, file);
+		offset += sizeof(level.time) + sizeof(level.offset) + sizeof(level.size);
+	}
+
+	std::fwrite(&count, sizeof(count), 1, file);
+	std::fwrite(&indexOffset, sizeof(indexOffset), 1, file);
+	std::fwrite(&magic, sizeof(magic), 1, file);
+	offset += sizeof(count) + sizeof(indexOffset) + sizeof(magic);
+
+	std::fclose(file);
+	file = nullptr;
+}
+
+std::size_t SnapshotWriter::getLevels() const
+{
+	return levels.size();
+}
+
+std::uint64_t SnapshotWriter::getRawBytes() const
+{
+	return levels.size() * points * sizeof(double);
+}
+
+std::uint64_t SnapshotWriter::getCompressedBytes() const
+{
+	return offset;
+}
@@ -0,0 +1,96 @@
+#pragma once // Include guard
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+/**
+* Writer of the compressed time series files of the grid values
+* \nEvery time level is delta encoded against the previous one and packed with the SnapshotCodec. Every keyframeInterval-th
+* \nlevel is a keyframe without prediction, and the index at the end of the file stores the time and the position of every
+* \nlevel, so the SnapshotReader decodes at most keyframeInterval levels to reach any of them.
+* \nIn the lossless mode the bit patterns of the values are stored exactly. In the lossy mode the values are quantised
+* \nto the multiples of 2 * tolerance, so the error of every value is at most the tolerance, and the smooth solutions
+* \nhave small quantised differences between the time levels.
+*
+* File layout (native byte order):
+* \n-header: magic, number of the values per level, tolerance (0 for lossless), keyframe interval
+* \n-the packed levels
+* \n-index: time, offset and size of every level, then the number of the levels, the offset of the index and the index magic
+*
+* The SnapshotWriter class provides:
+* \n-write function to append a time level
+* \n-close function to write the index
+* \n-getRawBytes and getCompressedBytes functions to report the compression
+*/
+class SnapshotWriter
+{
+	/**
+	* The index entry of a time level
+	*/
+	struct Level
+	{
+		double time;
+		std::uint64_t offset, size;
+	};
+
+	std::FILE* file;
+	std::uint64_t points;
+	double tolerance;
+	int keyframeInterval;
+	std::vector<Level> levels;
+	std::vector<std::uint64_t> previous, words, residuals;
+	std::vector<unsigned char> buffer;
+	std::uint64_t offset;
+
+public:
+	/**
+	* Constructor that creates the file and writes its header
+	* Throws std::runtime_error if the file cannot be created
+	* @param path std::string - The path of the file
+	* @param points std::size_t - The number of the values of every level
+	* @param tolerance double - The maximum error of the lossy mode (default value is 0, lossless)
+	* @param keyframeInterval int - The number of the levels between two keyframes (default value is 16)
+	*/
+	SnapshotWriter(const std::string& path, std::size_t points, double tolerance = 0, int keyframeInterval = 16);
+
+	/**
+	* Destructor that closes the file if close was not called
+	*/
+	~SnapshotWriter();
+
+	SnapshotWriter(const SnapshotWriter& that) = delete;
+	SnapshotWriter & operator=(const SnapshotWriter&) = delete;
+
+	/**
+	* Function that compresses and appends a time level
+	* Throws std::invalid_argument if a value cannot be quantised in the lossy mode, std::runtime_error on I/O errors
+	* @param time double - The time of the level
+	* @param values const double* - The values of the level
+	*/
+	void write(double time, const double* values);
+
+	/**
+	* Function that writes the index and closes the file
+	*/
+	void close();
+
+	/**
+	* Function that returns the number of the written levels
+	* @return std::size_t - The number of the levels
+	*/
+	std::size_t getLevels() const;
+
+	/**
+	* Function that returns the size of the written levels as raw doubles
+	* @return std::uint64_t - The uncompressed size in bytes
+	*/
+	std::uint64_t getRawBytes() const;
+
+	/**
+	* Function that returns the size of the file
+	* @return std::uint64_t - The compressed size in bytes
+	*/
+	std::uint64_t getCompressedBytes() const;
+};
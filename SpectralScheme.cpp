@@ -0,0 +1,100 @@
+#include <cmath>
+#include "SpectralScheme.h"
+
+static const double pi = 3.14159265358979323846;
+
+template <typename T>
+SpectralScheme<T>::SpectralScheme(double xStart, double xEnd, double t, int spacePoints, double u, double cfl)
+	: AbstractScheme<T>("Fourier Spectral Scheme", xStart, xEnd, t, spacePoints, u, cfl)
+{
+
+}
+
+template <typename T>
+std::unique_ptr<SimulationState<T>> SpectralScheme<T>::allocateState() const
+{
+	return std::unique_ptr<SimulationState<T>>(new State());
+}
+
+template <typename T>
+int SpectralScheme<T>::stencilRadius() const
+{
+	return this->spacePoints;
+}
+
+template <typename T>
+double SpectralScheme<T>::stepLength(double cfl, double deltaX, double t) const
+{
+	return t;
+}
+
+template <typename T>
+bool SpectralScheme<T>::isLocal() const
+{
+	return false;
+}
+
+template <typename T>
+bool SpectralScheme<T>::isPeriodic() const
+{
+	return true;
+}
+
+template <typename T>
+double SpectralScheme<T>::wavenumber(int mode, int size, double period)
+{
+	return 2 * pi * (2 * mode <= size ? mode : mode - size) / period;
+}
+
+template <typename T>
+void SpectralScheme<T>::prepare(SimulationState<T>& _state, std::shared_ptr<const BatchFunction> initialFunction) const
+{
+	auto& state = static_cast<State&>(_state);
+	auto size = state.spacePoints;
+	auto period = this->xEnd - this->xStart;
+
+	// The plans are shared by the runs on grids of the same size
+	state.plan = FFTPlan<T>::get(size);
+	state.spectrumReal.assign(state.currentValues.begin(), state.currentValues.begin() + size);
+	state.spectrumImaginary.assign(size, T(0));
+	state.real.resize(size);
+	state.imaginary.resize(size);
+	state.scratch.resize(2 * size);
+	state.wavenumbers.resize(size);
+
+	for (auto mode = 0; mode < size; mode++) {
+		state.wavenumbers[mode] = static_cast<T>(wavenumber(mode, size, period));
+	}
+
+	state.plan->forward(state.spectrumReal.data(), state.spectrumImaginary.data(), state.scratch.data());
+}
+
+template <typename T>
+const std::vector<T>& SpectralScheme<T>::calculateIteration(SimulationState<T>& _state, double t) const
+{
+	auto& state = static_cast<State&>(_state);
+	auto& values = state.currentValues;
+	auto size = state.spacePoints;
+	auto shift = this->u * t;
+
+	// The mode k of the wave f(x - u t) is the initial mode multiplied by e^(-i k u t)
+	for (auto mode = 0; mode < size; mode++) {
+		auto angle = -static_cast<double>(state.wavenumbers[mode]) * shift;
+		auto c = static_cast<T>(std::cos(angle)), s = static_cast<T>(std::sin(angle));
+
+		state.real[mode] = state.spectrumReal[mode] * c - state.spectrumImaginary[mode] * s;
+		state.imaginary[mode] = state.spectrumReal[mode] * s + state.spectrumImaginary[mode] * c;
+	}
+
+	state.plan->inverse(state.real.data(), state.imaginary.data(), state.scratch.data());
+
+	// The imaginary parts are rounding errors, except the Nyquist mode of the even sizes which is symmetrised by dropping it
+	std::copy(state.real.begin(), state.real.end(), values.begin());
+	values[size] = values[0];
+
+	return values;
+}
+
+// Explicit instantiation for the supported value types
+template class SpectralScheme<float>;
+template class SpectralScheme<double>;
@@ -0,0 +1,103 @@
+#pragma once // Include guard
+
+#include "AbstractScheme.h"
+#include "FFTPlan.h"
+
+/**
+* Fourier pseudo-spectral scheme class derived from the Abstract scheme
+* \nThe domain is periodic, the first spacePoints grid points carry the unknowns. The initial values are transformed
+* \nonce, the advection shifts the phase of every Fourier mode exactly (by -k u t), so the values of any time frame
+* \nare one inverse transform away: the scheme is exact in time and takes the whole time frame in one step.
+* \nThe accuracy is only limited by the resolution of the initial values, the smooth waves converge spectrally.
+*
+* The SpectralScheme class provides:
+* \n-wavenumber function to calculate the wavenumber of a Fourier mode
+*/
+template <typename T = double>
+class SpectralScheme : public AbstractScheme<T>
+{
+protected:
+	/**
+	* The state of a run of the spectral scheme
+	*/
+	class State : public SimulationState<T>
+	{
+	public:
+		/**
+		* The shared transform plan of the grid
+		*/
+		std::shared_ptr<const FFTPlan<T>> plan;
+
+		/**
+		* The Fourier coefficients of the initial values, the wavenumbers of the modes
+		* \nand the work arrays of the transform
+		*/
+		std::vector<T> spectrumReal, spectrumImaginary, wavenumbers, real, imaginary, scratch;
+	};
+
+	/**
+	* Override the state allocation to provide the spectrum
+	* @return std::unique_ptr<SimulationState<T>> - The new state
+	*/
+	std::unique_ptr<SimulationState<T>> allocateState() const override;
+
+	/**
+	* Override the preparation to transform the initial values of the run
+	*/
+	void prepare(SimulationState<T>& state, std::shared_ptr<const BatchFunction> initialFunction) const override;
+
+	/**
+	* The new values depend on every value of the grid
+	* @return int - The number of the space intervals
+	*/
+	int stencilRadius() const override;
+
+	/**
+	* The scheme is exact in time, the time step is the whole time frame
+	* @return double - The time frame
+	*/
+	double stepLength(double cfl, double deltaX, double t) const override;
+
+public:
+	/**
+	* Constructor for the spectral scheme
+	* @param xStart double - Beginning of the period
+	* @param xEnd double - End of the period
+	* @param t double - The timeframe until the calculations should be executed
+	* @param spacePoints int - The number of intervals in the space dimension (the number of the Fourier modes)
+	* @param u double - The velocity of the wave
+	* @param cfl double - The Courant number, it is only used by the runs with a given time step (variations, studies)
+	*/
+	SpectralScheme(double xStart, double xEnd, double t, int spacePoints, double u, double cfl);
+
+	/**
+	* Override the pure virtual function to calculate the values at the time frame from the initial spectrum
+	* The time frame is measured from the preparation of the state, so the steps can be skipped
+	* @param state SimulationState<T>& - The state of the run
+	* @param double t - The current time frame
+	* @return const std::vector<T>& - The calculated numerical values
+	*/
+	const std::vector<T>& calculateIteration(SimulationState<T>& state, double t) const override;
+
+	/**
+	* The new values depend on every value, the windows of the grid cannot be advanced separately
+	* @return bool - False
+	*/
+	bool isLocal() const override;
+
+	/**
+	* The domain of the scheme is periodic
+	* @return bool - True
+	*/
+	bool isPeriodic() const override;
+
+	/**
+	* Static public method that returns the wavenumber of a Fourier mode
+	* The modes above the half of the transform are the negative wavenumbers
+	* @param mode int - The index of the mode (0 ... size - 1)
+	* @param size int - The size of the transform
+	* @param period double - The length of the period
+	* @return double - The wavenumber
+	*/
+	static double wavenumber(int mode, int size, double period);
+};
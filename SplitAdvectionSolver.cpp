@@ -0,0 +1,292 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <future>
+#include <stdexcept>
+#include "Kernels.h"
+#include "SplitAdvectionSolver.h"
+#include "ThreadPool.h"
+#include "VectorNorms.h"
+
+// The number of the tasks per worker thread of a sweep, the pencils of the tasks are balanced by the pool
+static const unsigned int tasksPerThread = 4;
+
+template <typename T>
+SplitAdvectionSolver<T>::SplitAdvectionSolver(std::shared_ptr<const AbstractScheme<T>> _scheme, int _dimensions, FieldLayout _layout)
+	: scheme(_scheme), dimensions(_dimensions), layout(_layout)
+{
+	if (dimensions != 2 && dimensions != 3) {
+		throw std::invalid_argument("the split solver supports 2 and 3 dimensions");
+	}
+
+	auto stencils = scheme->getStencils(1);
+
+	if (stencils.size() != 1 || !stencils[0].next.empty()) {
+		throw std::invalid_argument(scheme->getName() + " has no explicit linear stencil, it cannot be split");
+	}
+}
+
+template <typename T>
+typename SplitAdvectionSolver<T>::SweepStencil SplitAdvectionSolver<T>::createStencil(double cfl) const
+{
+	scheme->checkStability(cfl);
+
+	auto stencil = scheme->getStencils(cfl)[0];
+
+	return SweepStencil{ stencil.first, std::vector<T>(stencil.current.begin(), stencil.current.end()) };
+}
+
+template <typename T>
+void SplitAdvectionSolver<T>::sweepLines(const T* in, T* out, int n, int width, int first, const std::vector<T>& coefficients)
+{
+	auto last = first + (int)coefficients.size() - 1;
+	auto lo = std::max(1, -first), hi = std::min(n - 1, n - last);
+	auto w = (std::size_t)width;
+
+	std::copy(in, in + w, out);
+	std::copy(in + n * w, in + (n + 1) * w, out + n * w);
+
+	// The nodes near the ends read the end nodes instead of the missing ones
+	auto clamped = [&](int p) {
+		for (std::size_t l = 0; l < w; l++) {
+			T sum = 0;
+
+			for (std::size_t m = 0; m < coefficients.size(); m++) {
+				sum += coefficients[m] * in[std::min(std::max(p + first + (int)m, 0), n) * w + l];
+			}
+
+			out[p * w + l] = sum;
+		}
+	};
+
+	for (auto p = 1; p < std::min(lo, n); p++) {
+		clamped(p);
+	}
+
+	for (auto p = std::max(hi + 1, lo); p < n; p++) {
+		clamped(p);
+	}
+
+	if (hi < lo) {
+		return;
+	}
+
+	// The lines are interleaved, so the neighbour m of every element is at the same offset and one loop covers all lines
+	auto target = out + lo * w;
+	auto count = (hi - lo + 1) * w;
+	auto source = in + (lo + first) * (std::ptrdiff_t)w;
+	auto& kernels = Kernels::get<T>();
+
+	kernels.scale(coefficients[0], source, target, count);
+
+	for (std::size_t m = 1; m < coefficients.size(); m++) {
+		kernels.axpy(coefficients[m], source + m * w, target, count);
+	}
+}
+
+template <typename T>
+void SplitAdvectionSolver<T>::sweep(Field<T>& field, int axis, const SweepStencil& stencil, ThreadPool& pool) const
+{
+	auto nx = field.getNx(), ny = field.getNy(), nz = field.getNz(), tileX = field.getTileX();
+	auto tilesX = (nx + tileX - 1) / tileX;
+	auto n = (axis == 0 ? nx : axis == 1 ? ny : nz) - 1;
+
+	// The pencils are the x lines, or the lines of a tile column along y or z
+	long long pencils = axis == 0 ? (long long)ny * nz : axis == 1 ? (long long)tilesX * nz : (long long)tilesX * ny;
+
+	// The pencil at (i, j, k) is gathered from (or scattered to) the rows of the tiles
+	auto transfer = [&](long long pencil, T* buffer, bool gather) {
+		if (axis == 0) {
+			auto j = (int)(pencil % ny), k = (int)(pencil / ny);
+
+			for (auto i = 0; i < nx; i += field.runLength(i)) {
+				auto row = field.run(i, j, k);
+				auto length = field.runLength(i);
+
+				if (gather) {
+					std::copy(row, row + length, buffer + i);
+				}
+				else
+				{
+					std::copy(buffer + i, buffer + i + length, row);
+				}
+			}
+		}
+		else
+		{
+			auto i = (int)(pencil % tilesX) * tileX, other = (int)(pencil / tilesX);
+			auto width = field.runLength(i);
+
+			for (auto p = 0; p <= n; p++) {
+				auto row = axis == 1 ? field.run(i, p, other) : field.run(i, other, p);
+
+				if (gather) {
+					std::copy(row, row + width, buffer + p * width);
+				}
+				else
+				{
+					std::copy(buffer + p * width, buffer + (p + 1) * width, row);
+				}
+			}
+		}
+	};
+
+	auto tasks = std::min((long long)pool.size() * tasksPerThread, pencils);
+	std::vector<std::future<void>> futures;
+
+	for (long long task = 0; task < tasks; task++) {
+		futures.push_back(pool.submit([&, task] {
+			auto maxWidth = axis == 0 ? 1 : tileX;
+			std::vector<T> in((std::size_t)(n + 1) * maxWidth), out(in.size());
+
+			for (auto pencil = pencils * task / tasks; pencil < pencils * (task + 1) / tasks; pencil++) {
+				auto width = axis == 0 ? 1 : field.runLength((int)(pencil % tilesX) * tileX);
+
+				// The lines along an axis are independent, so the new values are written back in place
+				transfer(pencil, in.data(), true);
+				sweepLines(in.data(), out.data(), n, width, stencil.first, stencil.coefficients);
+				transfer(pencil, out.data(), false);
+			}
+		}));
+	}
+
+	for (auto& future : futures) {
+		future.get();
+	}
+}
+
+template <typename T>
+void SplitAdvectionSolver<T>::writeTitle(std::ostream& stream) const
+{
+	auto n = scheme->getSpacePoints();
+
+	stream << "\n-----------------------\n" << dimensions << "D " << scheme->getName() << " (Strang splitting)\n-----------------------\n\n";
+	stream << "points " << n + 1 << "^" << dimensions << ", layout " << (layout == FieldLayout::RowMajor ? "row-major" : layout == FieldLayout::Tiled ? "tiled" : "morton")
+		<< ", time steps " << scheme->getTimeSteps() << std::endl << std::endl;
+}
+
+template <typename T>
+typename SplitAdvectionSolver<T>::Result SplitAdvectionSolver<T>::run(std::shared_ptr<const BatchFunction> function, ThreadPool& pool) const
+{
+	typedef std::chrono::steady_clock clock;
+
+	auto n = scheme->getSpacePoints();
+	auto grid = scheme->getGrid();
+	auto deltaT = scheme->getDeltaT();
+	auto cfl = scheme->getVelocity() * deltaT / grid->getDelta();
+	auto timeSteps = scheme->getTimeSteps();
+	auto nz = dimensions == 3 ? n + 1 : 1;
+	auto half = createStencil(0.5 * cfl), full = createStencil(cfl);
+
+	// The initial values are the products of the 1D values with the boundary values of the scheme
+	auto initial = scheme->discretise(*function);
+	Field<T> field(n + 1, n + 1, nz, layout);
+
+	for (auto k = 0; k < nz; k++) {
+		for (auto j = 0; j <= n; j++) {
+			auto factor = initial[j] * (dimensions == 3 ? initial[k] : T(1));
+
+			for (auto i = 0; i <= n; i++) {
+				field(i, j, k) = initial[i] * factor;
+			}
+		}
+	}
+
+	auto start = clock::now();
+
+	for (auto step = 1; step <= timeSteps; step++) {
+		sweep(field, 0, half, pool);
+
+		if (dimensions == 3) {
+			sweep(field, 1, half, pool);
+			sweep(field, 2, full, pool);
+			sweep(field, 1, half, pool);
+		}
+		else
+		{
+			sweep(field, 1, full, pool);
+		}
+
+		sweep(field, 0, half, pool);
+	}
+
+	std::chrono::duration<double> elapsed = clock::now() - start;
+
+	// The norms of the slices are combined, so the difference of the whole field is never stored
+	auto t = timeSteps * deltaT;
+	std::vector<double> exact(n + 1), difference(n + 1);
+	Result result{ 0.0, 0.0, 0.0, elapsed.count(), (long long)timeSteps * (n - 1) * (n - 1) * (dimensions == 3 ? n - 1 : 1), pool.size() };
+
+	function->evaluate(grid->coordinates(), t, exact.data(), exact.size());
+
+	for (auto k = 0; k < nz; k++) {
+		for (auto j = 0; j <= n; j++) {
+			auto factor = exact[j] * (dimensions == 3 ? exact[k] : 1.0);
+
+			for (auto i = 0; i <= n; i++) {
+				difference[i] = std::fabs(exact[i] * factor - static_cast<double>(field(i, j, k)));
+			}
+
+			auto second = VectorNorms<double>::pNorm(&difference, 2);
+
+			result.infinite = std::max(result.infinite, VectorNorms<double>::infiniteNorm(&difference));
+			result.first += VectorNorms<double>::pNorm(&difference, 1);
+			result.second += second * second;
+		}
+	}
+
+	result.second = std::sqrt(result.second);
+
+	return result;
+}
+
+template <typename T>
+typename SplitAdvectionSolver<T>::Result SplitAdvectionSolver<T>::solve(std::shared_ptr<const BatchFunction> function, std::ostream& stream) const
+{
+	writeTitle(stream);
+
+	auto result = run(function, ThreadPool::shared());
+
+	stream << "t = " << scheme->getTimeSteps() * scheme->getDeltaT() << std::endl;
+	stream << "infinite norm is " << result.infinite << std::endl;
+	stream << "1st norm is " << result.first << std::endl;
+	stream << "2nd norm is " << result.second << std::endl << std::endl;
+	stream << result.cellUpdates << " cell updates in " << result.seconds << "s, " << result.cellUpdates / std::max(result.seconds, 1e-9) / 1e6
+		<< " Mcells/s (" << result.threads << " threads)" << std::endl;
+
+	return result;
+}
+
+template <typename T>
+std::vector<typename SplitAdvectionSolver<T>::Result> SplitAdvectionSolver<T>::measureScaling(std::shared_ptr<const BatchFunction> function, std::ostream& stream) const
+{
+	auto hardwareThreads = std::max(std::thread::hardware_concurrency(), 1u);
+	std::vector<Result> results;
+
+	writeTitle(stream);
+	stream << "threads, seconds, Mcells/s, speedup, efficiency" << std::endl;
+
+	for (auto threads = 1u; ; threads = std::min(threads * 2, hardwareThreads)) {
+		ThreadPool pool(threads);
+
+		results.push_back(run(function, pool));
+
+		auto& result = results.back();
+		auto speedup = results[0].seconds / std::max(result.seconds, 1e-9);
+
+		stream << threads << ", " << result.seconds << ", " << result.cellUpdates / std::max(result.seconds, 1e-9) / 1e6 << ", "
+			<< speedup << ", " << speedup / threads << std::endl;
+
+		if (threads == hardwareThreads) {
+			break;
+		}
+	}
+
+	stream << std::endl;
+
+	return results;
+}
+
+// Explicit instantiation for the supported value types
+template class SplitAdvectionSolver<float>;
+template class SplitAdvectionSolver<double>;
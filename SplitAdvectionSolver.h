@@ -0,0 +1,118 @@
+#pragma once // Include guard
+
+#include <memory>
+#include <ostream>
+#include <vector>
+#include "AbstractScheme.h"
+#include "Field.h"
+#include "ThreadPool.h"
+
+/**
+* Solver of the 2D and 3D linear advection with Strang splitting of the 1D schemes
+* \nThe velocity and the grid of the scheme are used in every dimension. A time step is a sequence of 1D sweeps:
+* \nx/2, y, x/2 in 2D and x/2, y/2, z, y/2, x/2 in 3D, every sweep applies the linear stencil of the scheme
+* \n(the one of the von Neumann analysis) to the lines along its axis. The sweeps along y and z process
+* \nthe lines of a tile column together, so the inner loops run over contiguous x runs (vectorised);
+* \nthe pencils of lines are distributed to the shared thread pool.
+* \nThe initial and analytical values are the products of the 1D function in every dimension,
+* \nthe boundary nodes keep their initial values like the boundaries of the 1D schemes.
+*
+* The SplitAdvectionSolver class provides:
+* \n-solve function to run the scheme until its time frame and write the error norms and the throughput
+* \n-measureScaling function to compare the throughput of the same run with an increasing number of threads
+* \n-sweepLines function, the 1D stencil kernel on interleaved lines
+*
+* The values are stored with the T value type (float or double, default value is double)
+*/
+template <typename T = double>
+class SplitAdvectionSolver
+{
+public:
+	/**
+	* The error norms at the end of the run, the wall time, the number of the updated cells and the threads of the sweeps
+	*/
+	struct Result
+	{
+		double infinite, first, second, seconds;
+		long long cellUpdates;
+		unsigned int threads;
+	};
+
+	/**
+	* Constructor of the solver
+	* Throws std::invalid_argument if the dimensions are not 2 or 3, or the scheme has no single explicit linear stencil
+	* (the implicit, TVD and adaptive schemes cannot be split)
+	* @param scheme std::shared_ptr<const AbstractScheme<T>> - The 1D scheme applied along every axis
+	* @param dimensions int - The number of the dimensions (2 or 3)
+	* @param layout FieldLayout - The memory layout of the field (default value is Tiled)
+	*/
+	SplitAdvectionSolver(std::shared_ptr<const AbstractScheme<T>> scheme, int dimensions, FieldLayout layout = FieldLayout::Tiled);
+
+	/**
+	* Public method that runs the scheme from the initial values until its time frame
+	* It must not be called from a task of the shared thread pool, it waits for the sweeps
+	* Throws UnstableSchemeException if a sweep would diverge with its Courant number
+	* @param function std::shared_ptr<const BatchFunction> - The 1D initial and analytical function of every dimension
+	* @param stream std::ostream& - The stream of the norms and the throughput
+	* @return Result - The norms and the throughput of the run
+	*/
+	Result solve(std::shared_ptr<const BatchFunction> function, std::ostream& stream) const;
+
+	/**
+	* Public method that runs the scheme with 1, 2, 4 ... threads up to the hardware threads (the last count is the hardware threads)
+	* Every run has its own pool, so the shared pool is not used. The threads, the throughput, the speedup and the parallel
+	* \nefficiency against one thread are written to the stream, the norms are the same for every thread count
+	* Throws UnstableSchemeException if a sweep would diverge with its Courant number
+	* @param function std::shared_ptr<const BatchFunction> - The 1D initial and analytical function of every dimension
+	* @param stream std::ostream& - The stream of the throughput table
+	* @return std::vector<Result> - The results of the runs in the order of the thread counts
+	*/
+	std::vector<Result> measureScaling(std::shared_ptr<const BatchFunction> function, std::ostream& stream) const;
+
+	/**
+	* Static public method that applies a stencil to width interleaved lines of n + 1 nodes, the element l of the node p is at p * width + l
+	* The first and last nodes are copied, the stencil is clamped to the line near the ends
+	* @param in const T* - The values of the lines
+	* @param out T* - The new values (not the same array as in)
+	* @param n int - The number of the intervals of the lines
+	* @param width int - The number of the lines
+	* @param first int - The offset of the first coefficient
+	* @param coefficients const std::vector<T>& - The coefficients of the stencil
+	*/
+	static void sweepLines(const T* in, T* out, int n, int width, int first, const std::vector<T>& coefficients);
+
+private:
+	/**
+	* The stencil of a sweep in the value type of the field
+	*/
+	struct SweepStencil
+	{
+		int first;
+		std::vector<T> coefficients;
+	};
+
+	std::shared_ptr<const AbstractScheme<T>> scheme;
+	int dimensions;
+	FieldLayout layout;
+
+	/**
+	* Private method that returns the stencil of the scheme for a fraction of the time step
+	*/
+	SweepStencil createStencil(double cfl) const;
+
+	/**
+	* Private method that applies the stencil to every line of the field along the axis (0, 1 or 2), the pencils are distributed to the pool
+	*/
+	void sweep(Field<T>& field, int axis, const SweepStencil& stencil, ThreadPool& pool) const;
+
+	/**
+	* Private method that runs the scheme from the initial values until its time frame with the sweeps on the given pool
+	* @return Result - The norms and the throughput of the run
+	*/
+	Result run(std::shared_ptr<const BatchFunction> function, ThreadPool& pool) const;
+
+	/**
+	* Private method that writes the title of a run to the stream
+	*/
+	void writeTitle(std::ostream& stream) const;
+};
@@ -0,0 +1,134 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include "StabilityAnalysis.h"
+
+// The number of the sampled phase angles, the Courant number scan steps per unit and the rounding allowed above one
+static const int angleSamples = 512, scanSteps = 64;
+static const double growthTolerance = 1e-10, pi = 3.14159265358979323846;
+
+template <typename T>
+const double StabilityAnalysis<T>::searchLimit = 16;
+
+template <typename T>
+std::complex<double> StabilityAnalysis<T>::amplificationFactor(const Stencil& stencil, double theta)
+{
+	std::complex<double> current(0), next(0);
+
+	for (std::size_t k = 0; k < stencil.current.size(); k++) {
+		current += stencil.current[k] * std::polar(1.0, (stencil.first + (int)k) * theta);
+	}
+
+	for (std::size_t k = 0; k < stencil.next.size(); k++) {
+		next += stencil.next[k] * std::polar(1.0, (stencil.first + (int)k) * theta);
+	}
+
+	return stencil.next.empty() ? current : current / next;
+}
+
+template <typename T>
+double StabilityAnalysis<T>::maxAmplification(const AbstractScheme<T>& scheme, double cfl)
+{
+	auto stencils = scheme.getStencils(cfl);
+	auto amplification = stencils.empty() ? 1.0 : 0.0;
+
+	for (auto& stencil : stencils) {
+		for (auto i = 0; i <= angleSamples; i++) {
+			amplification = std::max(amplification, std::abs(amplificationFactor(stencil, pi * i / angleSamples)));
+		}
+	}
+
+	return amplification;
+}
+
+template <typename T>
+bool StabilityAnalysis<T>::isStable(const AbstractScheme<T>& scheme, double cfl)
+{
+	return maxAmplification(scheme, cfl) <= 1 + growthTolerance;
+}
+
+template <typename T>
+double StabilityAnalysis<T>::maxStableCfl(const AbstractScheme<T>& scheme)
+{
+	for (auto step = 1; step <= searchLimit * scanSteps; step++) {
+		auto high = (double)step / scanSteps;
+
+		if (isStable(scheme, high)) {
+			continue;
+		}
+
+		// The limit is between the last stable and the first unstable Courant number
+		auto low = (double)(step - 1) / scanSteps;
+
+		for (auto i = 0; i < 50; i++) {
+			auto middle = 0.5 * (low + high);
+
+			(isStable(scheme, middle) ? low : high) = middle;
+		}
+
+		return low;
+	}
+
+	return std::numeric_limits<double>::infinity();
+}
+
+template <typename T>
+double StabilityAnalysis<T>::accuracyCfl(const AbstractScheme<T>& scheme, double pointsPerWavelength, double errorGrowth)
+{
+	auto theta = 2 * pi / pointsPerWavelength;
+	auto limit = std::min(maxStableCfl(scheme), searchLimit);
+
+	// The difference from the exact shift of the mode by cfl cells, divided by the travelled cells
+	auto error = [&](double cfl) {
+		auto stencils = scheme.getStencils(cfl);
+		auto largest = 0.0;
+
+		for (auto& stencil : stencils) {
+			largest = std::max(largest, std::abs(amplificationFactor(stencil, theta) - std::polar(1.0, -cfl * theta)) / cfl);
+		}
+
+		return largest;
+	};
+
+	auto bound = errorGrowth * error(1e-4);
+
+	for (auto step = 1; step <= limit * scanSteps; step++) {
+		auto high = (double)step / scanSteps;
+
+		if (error(high) <= bound) {
+			continue;
+		}
+
+		auto low = (double)(step - 1) / scanSteps;
+
+		for (auto i = 0; i < 50; i++) {
+			auto middle = 0.5 * (low + high);
+
+			(error(middle) <= bound ? low : high) = middle;
+		}
+
+		return low;
+	}
+
+	return limit;
+}
+
+template <typename T>
+double StabilityAnalysis<T>::autoCfl(const AbstractScheme<T>& scheme)
+{
+	// Without stencils nothing is known about the scheme, it keeps its own Courant number
+	if (scheme.getStencils(1).empty()) {
+		return scheme.getVelocity() * scheme.getDeltaT() / scheme.getGrid()->getDelta();
+	}
+
+	// The accurate range is searched within the stable range, then the time step is shortened to reach t exactly
+	auto state = scheme.createState();
+	auto velocity = scheme.getVelocity();
+	auto steps = std::max(std::ceil(state->t * velocity / (accuracyCfl(scheme) * state->deltaX) - 1e-9), 1.0);
+
+	return velocity * (state->t / steps) / state->deltaX;
+}
+
+// Explicit instantiation for the supported value types
+template class StabilityAnalysis<float>;
+template class StabilityAnalysis<double>;
@@ -0,0 +1,85 @@
+#pragma once // Include guard
+
+#include <complex>
+#include "AbstractScheme.h"
+#include "Stencil.h"
+
+/**
+* Static class of the von Neumann stability analysis of the schemes
+* \nThe amplification factor of every Fourier mode is calculated from the stencil coefficients of the scheme,
+* \nthe scheme is stable if no factor is larger than one. The nonlinear schemes give the stencils of the linear schemes
+* \nthey are bounded by, and the scheme is stable if all of them are stable.
+* \nThe accuracy bound compares the amplitude and phase error of a resolved mode per travelled cell with the error
+* \nof the very small time steps, so the time step is only limited where it starts to dominate the error.
+*
+* The StabilityAnalysis class provides:
+* \n-amplificationFactor and maxAmplification functions to evaluate the factors
+* \n-isStable, maxStableCfl and accuracyCfl functions to find the limits of the Courant number
+* \n-autoCfl function to select the largest stable and accurate Courant number (the minimum number of time steps)
+*/
+template <typename T = double>
+class StabilityAnalysis
+{
+public:
+	/**
+	* The largest Courant number searched, the stable schemes up to it are unconditionally stable
+	*/
+	static const double searchLimit;
+
+	// Delete default member functions to emphasize that the class should only be used to access the static functions.
+	StabilityAnalysis() = delete;
+	~StabilityAnalysis() = delete;
+	StabilityAnalysis(const StabilityAnalysis& that) = delete;
+	StabilityAnalysis & operator=(const StabilityAnalysis&) = delete;
+
+	/**
+	* Static public method that returns the amplification factor of a Fourier mode
+	* @param stencil const Stencil& - The coefficients of the scheme
+	* @param theta double - The phase angle of the mode per grid cell (0 ... pi)
+	* @return std::complex<double> - The factor of the mode per time step
+	*/
+	static std::complex<double> amplificationFactor(const Stencil& stencil, double theta);
+
+	/**
+	* Static public method that returns the largest magnitude of the amplification factors of the scheme
+	* @param scheme const AbstractScheme<T>& - The analysed scheme
+	* @param cfl double - The Courant number
+	* @return double - The largest factor, 1 if the scheme provides no stencils
+	*/
+	static double maxAmplification(const AbstractScheme<T>& scheme, double cfl);
+
+	/**
+	* Static public method that tells if the scheme is stable with the Courant number
+	* @param scheme const AbstractScheme<T>& - The analysed scheme
+	* @param cfl double - The Courant number
+	* @return bool - True if no mode grows
+	*/
+	static bool isStable(const AbstractScheme<T>& scheme, double cfl);
+
+	/**
+	* Static public method that returns the largest stable Courant number
+	* The Courant numbers are scanned from zero, so the first unstable range bounds the result
+	* @param scheme const AbstractScheme<T>& - The analysed scheme
+	* @return double - The largest stable Courant number, infinity if the scheme is stable up to the search limit
+	*/
+	static double maxStableCfl(const AbstractScheme<T>& scheme);
+
+	/**
+	* Static public method that returns the largest accurate Courant number within the stable range
+	* @param scheme const AbstractScheme<T>& - The analysed scheme
+	* @param pointsPerWavelength double - The resolution of the mode that must stay accurate (default value is 20)
+	* @param errorGrowth double - The allowed error per travelled cell relative to the error of the very small time steps (default value is 2)
+	* @return double - The largest accurate Courant number, at most the search limit
+	*/
+	static double accuracyCfl(const AbstractScheme<T>& scheme, double pointsPerWavelength = 20, double errorGrowth = 2);
+
+	/**
+	* Static public method that returns the Courant number of the automatic mode
+	* It is the largest stable Courant number bounded by the accuracy, so the unconditionally stable schemes get a finite one,
+	* the schemes without stencils keep their own Courant number. It is reduced to the nearest one that reaches
+	* the time frame of the scheme with a whole number of time steps, so the run takes the minimum number of steps.
+	* @param scheme const AbstractScheme<T>& - The analysed scheme
+	* @return double - The selected Courant number
+	*/
+	static double autoCfl(const AbstractScheme<T>& scheme);
+};
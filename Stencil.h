@@ -0,0 +1,15 @@
+#pragma once // Include guard
+
+#include <vector>
+
+/**
+* The coefficients of a linear one step scheme for the von Neumann stability analysis
+* \nThe scheme is sum(next[k] * u[j + first + k]^(n + 1)) = sum(current[k] * u[j + first + k]^n),
+* \nso its amplification factor is sum(current[k] * e^(i (first + k) theta)) / sum(next[k] * e^(i (first + k) theta)).
+* \nThe explicit schemes leave the next coefficients empty, it means u[j]^(n + 1) on the left side.
+*/
+struct Stencil
+{
+	int first;
+	std::vector<double> current, next;
+};
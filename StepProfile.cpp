@@ -0,0 +1,27 @@
+#include <sstream>
+#include "StepProfile.h"
+
+StepProfile::StepProfile(double _velocity)
+	: velocity(_velocity)
+{
+
+}
+
+void StepProfile::evaluate(const double* x, double t, double* values, std::size_t count) const
+{
+	auto position = velocity * t;
+
+	for (std::size_t i = 0; i < count; i++) {
+		values[i] = 0.5 * ((x[i] > position) - (x[i] < position) + 1);
+	}
+}
+
+std::string StepProfile::getIdentity() const
+{
+	std::ostringstream identity;
+
+	identity.precision(17);
+	identity << "step " << velocity;
+
+	return identity.str();
+}
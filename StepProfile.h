@@ -0,0 +1,30 @@
+#pragma once // Include guard
+
+#include "BatchFunction.h"
+
+/**
+* Batch function class of a moving step
+* \nf(x, t) = 0.5 * (sgn(x - velocity * t) + 1), so the value is 0 left to the step, 1 right to it and 0.5 at the step
+*/
+class StepProfile : public BatchFunction
+{
+	double velocity;
+
+public:
+	/**
+	* Constructor for the step
+	* @param velocity double - The velocity of the wave
+	*/
+	explicit StepProfile(double velocity);
+
+	/**
+	* Override the pure virtual function to evaluate the step at the given points
+	* The loop is branch free, so it is vectorised by the compiler
+	*/
+	void evaluate(const double* x, double t, double* values, std::size_t count) const override;
+
+	/**
+	* Override the identity with the velocity of the step
+	*/
+	std::string getIdentity() const override;
+};
@@ -0,0 +1,274 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <future>
+#include <stdexcept>
+#include "StreamingSolver.h"
+
+template <typename T>
+StreamingSolver<T>::StreamingSolver(std::shared_ptr<const AbstractScheme<T>> _scheme, long long _spacePoints, std::string _directory, int _chunkSize, double _diskBandwidth)
+	: scheme(_scheme), spacePoints(_spacePoints), chunkSize(_chunkSize), directory(_directory), diskBandwidth(_diskBandwidth)
+{
+	if (!scheme->isLocal()) {
+		throw std::invalid_argument(scheme->getName() + " is not local, it cannot be solved out-of-core");
+	}
+
+	if (spacePoints < 2 || chunkSize < 2 * scheme->getStencilRadius() || chunkSize > (1 << 28)) {
+		throw std::invalid_argument("the chunks must contain the stencil and the grid at least two intervals");
+	}
+}
+
+template <typename T>
+void StreamingSolver<T>::readValues(std::FILE* file, long long first, T* values, std::size_t count)
+{
+#ifdef _WIN32
+	auto failed = _fseeki64(file, first * (long long)sizeof(T), SEEK_SET) != 0;
+#else
+	auto failed = fseeko(file, (off_t)(first * (long long)sizeof(T)), SEEK_SET) != 0;
+#endif
+
+	if (failed || std::fread(values, sizeof(T), count, file) != count) {
+		throw std::runtime_error("the out-of-core values cannot be read");
+	}
+}
+
+template <typename T>
+void StreamingSolver<T>::writeValues(std::FILE* file, long long first, const T* values, std::size_t count)
+{
+#ifdef _WIN32
+	auto failed = _fseeki64(file, first * (long long)sizeof(T), SEEK_SET) != 0;
+#else
+	auto failed = fseeko(file, (off_t)(first * (long long)sizeof(T)), SEEK_SET) != 0;
+#endif
+
+	if (failed || std::fwrite(values, sizeof(T), count, file) != count) {
+		throw std::runtime_error("the out-of-core values cannot be written");
+	}
+}
+
+template <typename T>
+double StreamingSolver<T>::measureBandwidth(const std::string& directory, std::size_t bytes)
+{
+	typedef std::chrono::steady_clock clock;
+
+	auto path = directory + "/bandwidth.bin";
+	std::vector<char> block(1 << 20, 1);
+	auto start = clock::now();
+	auto file = std::fopen(path.c_str(), "w+b");
+
+	if (file == nullptr) {
+		throw std::runtime_error("the bandwidth of " + directory + " cannot be measured");
+	}
+
+	for (std::size_t written = 0; written < bytes; written += block.size()) {
+		std::fwrite(block.data(), 1, block.size(), file);
+	}
+
+	std::fflush(file);
+	std::rewind(file);
+
+	while (std::fread(block.data(), 1, block.size(), file) == block.size()) {
+	}
+
+	std::fclose(file);
+	std::remove(path.c_str());
+
+	std::chrono::duration<double> elapsed = clock::now() - start;
+
+	return 2.0 * bytes / elapsed.count();
+}
+
+template <typename T>
+typename StreamingSolver<T>::Result StreamingSolver<T>::solve(std::shared_ptr<const BatchFunction> function, std::ostream& stream, int checkpointInterval)
+{
+	// The diverging runs fail before the files of the whole grid are written
+	scheme->checkStability(scheme->getVelocity() * scheme->getDeltaT() / scheme->getGrid()->getDelta());
+
+	if (diskBandwidth <= 0) {
+		diskBandwidth = measureBandwidth(directory);
+	}
+
+	std::string paths[] = { directory + "/values_a.bin", directory + "/values_b.bin" };
+	std::FILE* files[] = { std::fopen(paths[0].c_str(), "w+b"), std::fopen(paths[1].c_str(), "w+b") };
+
+	// The files are removed on errors too, the closed handles are cleared so a second call does not close them again
+	auto close = [&]() {
+		for (auto i = 0; i < 2; i++) {
+			if (files[i] != nullptr) {
+				std::fclose(files[i]);
+				files[i] = nullptr;
+			}
+
+			std::remove(paths[i].c_str());
+		}
+	};
+
+	try {
+		if (files[0] == nullptr || files[1] == nullptr) {
+			throw std::runtime_error("the out-of-core value files cannot be created in " + directory);
+		}
+
+		auto result = advance(files[0], files[1], function, stream, checkpointInterval);
+
+		close();
+
+		return result;
+	}
+	catch (...) {
+		close();
+		throw;
+	}
+}
+
+template <typename T>
+typename StreamingSolver<T>::Result StreamingSolver<T>::advance(std::FILE* current, std::FILE* next, std::shared_ptr<const BatchFunction> function, std::ostream& stream, int checkpointInterval)
+{
+	typedef std::chrono::steady_clock clock;
+
+	// The scheme's state provides the derived per-run data, the grid values are overwritten by the windows
+	auto state = scheme->createState();
+	auto grid = scheme->getGrid();
+	auto xStart = grid->getStart(), xEnd = grid->getEnd();
+	auto deltaX = (xEnd - xStart) / spacePoints;
+	auto deltaT = (state->cfl * deltaX) / scheme->getVelocity();
+	auto timeSteps = (int)std::floor(state->t / deltaT + 1e-9);
+	auto halo = (long long)scheme->getStencilRadius();
+	auto chunks = (spacePoints + chunkSize) / chunkSize;
+
+	state->grid = nullptr;
+	state->deltaX = deltaX;
+	state->deltaT = deltaT;
+
+	std::vector<double> coordinates(chunkSize), analytical(chunkSize);
+	std::vector<T> values[2] = { std::vector<T>(chunkSize), std::vector<T>(chunkSize) };
+
+	// The coordinates of the nodes first ... first + count - 1, the last one is exactly the end of the domain
+	auto fillCoordinates = [&](long long first, std::size_t count) {
+		for (std::size_t i = 0; i < count; i++) {
+			coordinates[i] = first + (long long)i == spacePoints ? xEnd : xStart + (first + (long long)i) * deltaX;
+		}
+	};
+
+	// The initial values are written chunk by chunk
+	for (long long k = 0; k < chunks; k++) {
+		auto first = k * chunkSize;
+		auto count = (std::size_t)(std::min(first + chunkSize - 1, spacePoints) - first + 1);
+
+		fillCoordinates(first, count);
+		function->evaluate(coordinates.data(), 0.0, analytical.data(), count);
+		std::copy(analytical.begin(), analytical.begin() + count, values[0].begin());
+
+		if (first == 0) {
+			values[0][0] = scheme->getLeftBoundary();
+		}
+
+		if (first + (long long)count - 1 == spacePoints) {
+			values[0][count - 1] = scheme->getRightBoundary();
+		}
+
+		writeValues(current, first, values[0].data(), count);
+	}
+
+	stream << "\n-----------------------\nOut-of-core " << scheme->getName() << "\n-----------------------\n\n";
+	stream << "points " << spacePoints + 1 << ", chunk " << chunkSize << ", halo " << halo << ", time steps " << timeSteps << std::endl << std::endl;
+
+	Result result{ 0.0, 0.0, 0.0, 0.0, 0 };
+	auto start = clock::now();
+
+	// The window of the chunk k, it is read on a background thread
+	auto readWindow = [&](long long k) {
+		auto first = std::max(k * chunkSize - halo, 0LL);
+		auto last = std::min((k + 1) * chunkSize - 1 + halo, spacePoints);
+		std::vector<T> window((std::size_t)(last - first + 1));
+
+		readValues(current, first, window.data(), window.size());
+
+		return window;
+	};
+
+	for (auto step = 1; step <= timeSteps; step++) {
+		auto measure = step == timeSteps || (checkpointInterval > 0 && step % checkpointInterval == 0);
+		auto infinite = 0.0, firstNorm = 0.0, secondNorm = 0.0;
+
+		// The I/O waits on the disk, so it runs on own threads instead of the compute pool
+		auto prefetch = std::async(std::launch::async, readWindow, 0LL);
+		std::future<void> pendingWrite;
+
+		for (long long k = 0; k < chunks; k++) {
+			auto first = k * chunkSize;
+			auto last = std::min(first + chunkSize - 1, spacePoints);
+			auto windowFirst = std::max(first - halo, 0LL);
+
+			state->currentValues = prefetch.get();
+
+			if (k + 1 < chunks) {
+				prefetch = std::async(std::launch::async, readWindow, k + 1);
+			}
+
+			result.bytes += state->currentValues.size() * sizeof(T);
+
+			// The window is the whole grid for the scheme, the halo nodes are not written back
+			state->spacePoints = (int)state->currentValues.size() - 1;
+			state->nextValues.resize(state->currentValues.size());
+			state->activeFirst = (int)(first - windowFirst);
+			state->activeLast = (int)(last - windowFirst);
+
+			auto& updated = scheme->calculateIteration(*state, step * deltaT);
+			auto count = (std::size_t)(last - first + 1);
+
+			if (measure) {
+				fillCoordinates(first, count);
+				function->evaluate(coordinates.data(), step * deltaT, analytical.data(), count);
+
+				for (std::size_t i = 0; i < count; i++) {
+					auto difference = std::fabs(analytical[i] - static_cast<double>(updated[state->activeFirst + i]));
+
+					infinite = std::max(infinite, difference);
+					firstNorm += difference;
+					secondNorm += difference * difference;
+				}
+			}
+
+			// The buffers are used alternately, the write of the previous chunk uses the other one
+			auto buffer = values[k % 2].data();
+
+			std::copy(updated.begin() + state->activeFirst, updated.begin() + state->activeFirst + count, buffer);
+
+			if (pendingWrite.valid()) {
+				pendingWrite.get();
+			}
+
+			pendingWrite = std::async(std::launch::async, [next, first, buffer, count] { writeValues(next, first, buffer, count); });
+			result.bytes += count * sizeof(T);
+		}
+
+		pendingWrite.get();
+		std::fflush(next);
+		std::swap(current, next);
+
+		if (measure) {
+			stream << "t = " << step * deltaT << std::endl;
+			stream << "infinite norm is " << infinite << std::endl;
+			stream << "1st norm is " << firstNorm << std::endl;
+			stream << "2nd norm is " << std::sqrt(secondNorm) << std::endl << std::endl;
+
+			result.infinite = infinite;
+			result.first = firstNorm;
+			result.second = std::sqrt(secondNorm);
+		}
+	}
+
+	std::chrono::duration<double> elapsed = clock::now() - start;
+	result.seconds = elapsed.count();
+
+	auto throughput = result.bytes / std::max(result.seconds, 1e-9);
+
+	stream << "streamed " << result.bytes / 1e6 << " MB in " << result.seconds << "s, " << throughput / 1e6 << " MB/s, "
+		<< 100.0 * throughput / diskBandwidth << "% of the disk bandwidth (" << diskBandwidth / 1e6 << " MB/s)" << std::endl << std::endl;
+
+	return result;
+}
+
+// Explicit instantiation for the supported value types
+template class StreamingSolver<float>;
+template class StreamingSolver<double>;
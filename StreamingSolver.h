@@ -0,0 +1,88 @@
+#pragma once // Include guard
+
+#include <cstdio>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "AbstractScheme.h"
+#include "BatchFunction.h"
+
+/**
+* Out-of-core driver of the local schemes for grids larger than the memory
+* \nThe values of the current and the next time step are kept in two files of the given directory. Every time step
+* \nstreams the grid through the scheme in chunks: the window of a chunk is extended by the stencil radius on both sides
+* \n(halo), so the scheme updates the chunk with its own calculateIteration as if it was the whole grid.
+* \nThe next window is read and the previous chunk is written on background threads while the current chunk is calculated.
+* \nThe error norms are accumulated chunk by chunk, only the windows are kept in memory.
+*
+* The state of the scheme is stored with the T value type (float or double, default value is double)
+*
+* The StreamingSolver class provides:
+* \n-solve function to run the scheme on the files and report the errors and the throughput
+* \n-measureBandwidth function to measure the sequential bandwidth of a directory
+*/
+template <typename T = double>
+class StreamingSolver
+{
+public:
+	/**
+	* The error norms at the last time step and the throughput of a run
+	*/
+	struct Result
+	{
+		double infinite, first, second, seconds;
+		long long bytes;
+	};
+
+private:
+	std::shared_ptr<const AbstractScheme<T>> scheme;
+	long long spacePoints;
+	int chunkSize;
+	std::string directory;
+	double diskBandwidth;
+
+	/**
+	* Private methods that read or write count values starting with the given node, the files can exceed 2 GB
+	* Throw std::runtime_error on I/O errors
+	*/
+	static void readValues(std::FILE* file, long long first, T* values, std::size_t count);
+	static void writeValues(std::FILE* file, long long first, const T* values, std::size_t count);
+
+	/**
+	* Private method that advances the files with the scheme, the files are created and removed by solve
+	*/
+	Result advance(std::FILE* current, std::FILE* next, std::shared_ptr<const BatchFunction> function, std::ostream& stream, int checkpointInterval);
+
+public:
+	/**
+	* Constructor for the out-of-core driver
+	* Throws std::invalid_argument if the scheme is not local or its stencil does not fit into a chunk
+	* @param scheme std::shared_ptr<const AbstractScheme<T>> - The local scheme, its function (and so the boundary values) must be set
+	* @param spacePoints long long - The number of intervals in the space dimension, it can exceed the range of the scheme's int
+	* @param directory std::string - The directory of the value files
+	* @param chunkSize int - The number of the nodes updated together (default value is 2^20)
+	* @param diskBandwidth double - The bandwidth of the directory in bytes per second (default value is 0, measured by the first solve)
+	*/
+	StreamingSolver(std::shared_ptr<const AbstractScheme<T>> scheme, long long spacePoints, std::string directory, int chunkSize = 1 << 20, double diskBandwidth = 0);
+
+	/**
+	* Static public method that measures the sequential write and read bandwidth of a directory with a temporary file
+	* The operating system may cache the file, so the result is an upper estimate for small files
+	* @param directory std::string - The directory to be measured
+	* @param bytes std::size_t - The size of the temporary file (default value is 64 MB)
+	* @return double - The bandwidth in bytes per second
+	*/
+	static double measureBandwidth(const std::string& directory, std::size_t bytes = 64 << 20);
+
+	/**
+	* Function that solves the problem until the time frame of the scheme and writes the error norms and the throughput
+	* The throughput is also given as the fraction of the disk bandwidth
+	* Throws UnstableSchemeException if the scheme would diverge with its Courant number
+	* @param function std::shared_ptr<const BatchFunction> - The initial and analytical function
+	* @param stream std::ostream& - The stream to write the results to
+	* @param checkpointInterval int - The number of the time steps between two written error norms (0 writes the last time step only)
+	* @return Result - The error norms at the last time step and the throughput
+	*/
+	Result solve(std::shared_ptr<const BatchFunction> function, std::ostream& stream, int checkpointInterval = 0);
+};
@@ -0,0 +1,124 @@
+#include <algorithm>
+#include <cmath>
+#include "TVDScheme.h"
+
+template <typename T>
+TVDScheme<T>::TVDScheme(double xStart, double xEnd, double t, int spacePoints, double u, double cfl, FluxLimiter _limiter)
+	: FluxFormScheme<T>(limiterName(_limiter) + " TVD Scheme", xStart, xEnd, t, spacePoints, u, cfl), limiter(_limiter)
+{
+
+}
+
+template <typename T>
+int TVDScheme<T>::stencilRadius() const
+{
+	return 2;
+}
+
+template <typename T>
+int TVDScheme<T>::boundaryCells() const
+{
+	return 1;
+}
+
+template <typename T>
+T TVDScheme<T>::limit(FluxLimiter limiter, T r)
+{
+	const T zero = 0, one = 1, two = 2;
+
+	switch (limiter) {
+	case FluxLimiter::Upwind:
+		return zero;
+	case FluxLimiter::LaxWendroff:
+		return one;
+	case FluxLimiter::Minmod:
+		return std::max(zero, std::min(one, r));
+	case FluxLimiter::VanLeer:
+		return (r + std::fabs(r)) / (one + std::fabs(r));
+	case FluxLimiter::Superbee:
+		return std::max(zero, std::max(std::min(two * r, one), std::min(r, two)));
+	}
+
+	return zero;
+}
+
+template <typename T>
+T TVDScheme<T>::limitedFlux(T qm, T q0, T qp, T qpp, T u, T nu, FluxLimiter limiter)
+{
+	const T half = 0.5, one = 1;
+	auto delta = qp - q0;
+
+	// Constant data, the correction term vanishes
+	if (delta == 0) {
+		return u >= 0 ? u * q0 : u * qp;
+	}
+
+	if (u >= 0) {
+		return u * q0 + half * u * (one - nu) * limit(limiter, (q0 - qm) / delta) * delta;
+	}
+
+	return u * qp - half * u * (one + nu) * limit(limiter, (qpp - qp) / delta) * delta;
+}
+
+template <typename T>
+std::string TVDScheme<T>::limiterName(FluxLimiter limiter)
+{
+	switch (limiter) {
+	case FluxLimiter::Upwind:
+		return "Upwind";
+	case FluxLimiter::LaxWendroff:
+		return "Lax-Wendroff";
+	case FluxLimiter::Minmod:
+		return "Minmod";
+	case FluxLimiter::VanLeer:
+		return "Van Leer";
+	case FluxLimiter::Superbee:
+		return "Superbee";
+	}
+
+	return "Unknown";
+}
+
+// Define the pure virtual function of the base class
+template <typename T>
+void TVDScheme<T>::calculateFluxes(typename FluxFormScheme<T>::State& state, int first, int last) const
+{
+	auto& q = state.currentValues;
+	auto& fluxes = state.fluxes;
+	auto spacePoints = state.spacePoints;
+	auto u = static_cast<T>(this->u);
+	auto nu = static_cast<T>(this->u * state.deltaT / state.deltaX);
+
+	for (auto i = first; i <= last; i++) {
+		fluxes[i] = limitedFlux(q[std::max(i - 1, 0)], q[i], q[i + 1], q[std::min(i + 2, spacePoints)], u, nu, limiter);
+	}
+}
+
+template <typename T>
+std::vector<Stencil> TVDScheme<T>::linearisedStencils(double cfl, FluxLimiter limiter)
+{
+	std::vector<Stencil> stencils;
+
+	for (auto phi : { 0.0, 1.0 }) {
+		if ((limiter == FluxLimiter::Upwind && phi != 0) || (limiter == FluxLimiter::LaxWendroff && phi != 1)) {
+			continue;
+		}
+
+		// The flux difference of the limited fluxes with the constant phi
+		auto correction = 0.5 * cfl * (1 - cfl) * phi;
+
+		stencils.push_back(Stencil{ -1, { cfl - correction, 1 - cfl + 2 * correction, -correction }, {} });
+	}
+
+	return stencils;
+}
+
+template <typename T>
+std::vector<Stencil> TVDScheme<T>::getStencils(double cfl) const
+{
+	return linearisedStencils(cfl, limiter);
+}
+
+// Explicit instantiation for the supported value types
+template class TVDScheme<float>;
+template class TVDScheme<double>;
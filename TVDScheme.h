@@ -0,0 +1,97 @@
+#pragma once // Include guard
+
+#include "FluxFormScheme.h"
+
+/**
+* The flux limiters available for the TVD scheme
+* \nUpwind and LaxWendroff are the two unlimited extremes (phi = 0 and phi = 1)
+*/
+enum class FluxLimiter { Upwind, LaxWendroff, Minmod, VanLeer, Superbee };
+
+/**
+* Flux limited second order (TVD) scheme class derived from the Flux-form scheme
+* It overrides the default implementation of the flux function
+*
+* The TVDScheme class provides:
+* \n-limiter function to evaluate the flux limiter for a given smoothness ratio
+* \n-limitedFlux function to calculate a single limited interface flux
+*/
+template <typename T = double>
+class TVDScheme : public FluxFormScheme<T>
+{
+	FluxLimiter limiter;
+
+protected:
+	/**
+	* Override the pure virtual function to calculate the limited fluxes
+	* The missing neighbours at the boundaries are replaced with the boundary cells
+	*/
+	void calculateFluxes(typename FluxFormScheme<T>::State& state, int first, int last) const override;
+
+	/**
+	* The limited fluxes use the i-2 ... i+1 cells
+	* @return int - The radius of the stencil
+	*/
+	int stencilRadius() const override;
+
+	/**
+	* Only the first and last cells are kept at the boundary values
+	* @return int - The number of boundary cells
+	*/
+	int boundaryCells() const override;
+
+public:
+	/**
+	* Constructor for the TVD scheme
+	* @param xStart double - Beginning of the space dimension
+	* @param xEnd double - End of the space dimension
+	* @param t double - The timeframe until the calculations should be executed
+	* @param spacePoints int - The number of intervals in the space dimension
+	* @param u double - The velocity of the wave
+	* @param limiter FluxLimiter - The flux limiter to be used
+	*/
+	TVDScheme(double xStart, double xEnd, double t, int spacePoints, double u, double cfl, FluxLimiter limiter);
+
+	/**
+	* Static public method that returns the value of the flux limiter
+	* @param limiter FluxLimiter - The flux limiter to be used
+	* @param r T - The ratio of the consecutive gradients
+	* @return T - The value of the limiter function
+	*/
+	static T limit(FluxLimiter limiter, T r);
+
+	/**
+	* Static public method that returns the limited flux between the q0 and qp cells
+	* @param qm T - The value of the cell left to q0
+	* @param q0 T - The value of the cell left to the interface
+	* @param qp T - The value of the cell right to the interface
+	* @param qpp T - The value of the cell right to qp
+	* @param u T - The velocity of the wave
+	* @param nu T - The Courant number (u * deltaT / deltaX)
+	* @param limiter FluxLimiter - The flux limiter to be used
+	* @return T - The numerical flux
+	*/
+	static T limitedFlux(T qm, T q0, T qp, T qpp, T u, T nu, FluxLimiter limiter);
+
+	/**
+	* Static public method that returns the name of the limiter
+	* @param limiter FluxLimiter - The flux limiter
+	* @return std::string - The name of the limiter
+	*/
+	static std::string limiterName(FluxLimiter limiter);
+
+	/**
+	* Static public method that returns the stencils of the linear schemes bounding the limited scheme
+	* With a constant limiter value phi the scheme is linear, the upwind (phi = 0) and the Lax-Wendroff (phi = 1)
+	* schemes bound the limiters of the TVD region, so the limited scheme is stable where both of them are stable
+	* @param cfl double - The Courant number
+	* @param limiter FluxLimiter - The flux limiter
+	* @return std::vector<Stencil> - The stencils of the bounding linear schemes
+	*/
+	static std::vector<Stencil> linearisedStencils(double cfl, FluxLimiter limiter);
+
+	/**
+	* Override the stencils with the bounding linear schemes of the limiter
+	*/
+	std::vector<Stencil> getStencils(double cfl) const override;
+};
@@ -0,0 +1,76 @@
+#include <algorithm>
+#include <memory>
+#include "ThreadPool.h"
+
+ThreadPool::ThreadPool(unsigned int threads)
+	: stopping(false)
+{
+	threads = std::max(threads, 1u);
+
+	for (auto i = 0u; i < threads; i++) {
+		workers.emplace_back(&ThreadPool::work, this);
+	}
+}
+
+ThreadPool::~ThreadPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopping = true;
+	}
+
+	condition.notify_all();
+
+	for (auto& worker : workers) {
+		worker.join();
+	}
+}
+
+void ThreadPool::work()
+{
+	while (true) {
+		std::function<void()> task;
+
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			condition.wait(lock, [this] { return stopping || !tasks.empty(); });
+
+			if (tasks.empty()) {
+				return;
+			}
+
+			task = std::move(tasks.front());
+			tasks.pop();
+		}
+
+		task();
+	}
+}
+
+std::future<void> ThreadPool::submit(std::function<void()> task)
+{
+	// std::function must be copyable, so the packaged task is shared
+	auto packaged = std::make_shared<std::packaged_task<void()>>(std::move(task));
+	auto future = packaged->get_future();
+
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		tasks.push([packaged] { (*packaged)(); });
+	}
+
+	condition.notify_one();
+
+	return future;
+}
+
+unsigned int ThreadPool::size() const
+{
+	return workers.size();
+}
+
+ThreadPool& ThreadPool::shared()
+{
+	static ThreadPool pool;
+
+	return pool;
+}
@@ -0,0 +1,68 @@
+#pragma once // Include guard
+
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+/**
+* A fixed size pool of worker threads executing the submitted tasks in submission order
+* \nThe threads are created once, so the tasks do not pay for the thread creation
+*
+* The ThreadPool class provides:
+* \n-submit function to queue a task and get a future for its completion
+* \n-size function to retrieve the number of the worker threads
+* \n-shared function to access the process-wide pool
+*/
+class ThreadPool
+{
+	std::vector<std::thread> workers;
+	std::queue<std::function<void()>> tasks;
+	std::mutex mutex;
+	std::condition_variable condition;
+	bool stopping;
+
+	/**
+	* Private method executed by the worker threads, it runs the queued tasks until the pool is destroyed
+	*/
+	void work();
+
+public:
+	/**
+	* Constructor to start the worker threads
+	* @param threads unsigned int - The number of the worker threads (at least one thread is started)
+	*/
+	explicit ThreadPool(unsigned int threads = std::thread::hardware_concurrency());
+
+	/**
+	* Destructor that finishes the queued tasks and joins the worker threads
+	*/
+	~ThreadPool();
+
+	// The pool owns its threads, it can not be copied
+	ThreadPool(const ThreadPool& that) = delete;
+	ThreadPool & operator=(const ThreadPool&) = delete;
+
+	/**
+	* Public method to queue a task for the worker threads
+	* The exceptions thrown by the task are rethrown by the get function of the future
+	* @param task std::function<void()> - The task to be executed
+	* @return std::future<void> - The future signalling the completion of the task
+	*/
+	std::future<void> submit(std::function<void()> task);
+
+	/**
+	* Public method that returns the number of the worker threads
+	* @return unsigned int - The number of the worker threads
+	*/
+	unsigned int size() const;
+
+	/**
+	* Static public method that returns the process-wide pool with one thread per hardware thread
+	* @return ThreadPool& - The shared pool
+	*/
+	static ThreadPool& shared();
+};
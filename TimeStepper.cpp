@@ -0,0 +1,131 @@
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+#include "TimeStepper.h"
+
+template <typename T>
+TimeStepper<T>::TimeStepper(const AbstractScheme<T>& _scheme, SimulationState<T>& _state, std::shared_ptr<const BatchFunction> _initialFunction, int _interval)
+	: scheme(_scheme), state(_state), initialFunction(_initialFunction), interval(std::max(_interval, 1)), step(-1), values(&_state.currentValues),
+	status(Status::Running), divergenceFactor(0), bound(0)
+{
+
+}
+
+template <typename T>
+bool TimeStepper<T>::next()
+{
+	if (status != Status::Running) {
+		return false;
+	}
+
+	if (step < 0) {
+		scheme.initialise(state, initialFunction);
+		step = 0;
+		values = &state.currentValues;
+
+		// The bound of the divergence guard is relative to the initial values
+		auto largest = 1.0;
+
+		for (auto value : state.currentValues) {
+			largest = std::max(largest, (double)std::fabs(value));
+		}
+
+		bound = divergenceFactor * largest;
+
+		return check();
+	}
+
+	if (step >= state.timeSteps) {
+		status = Status::Finished;
+
+		return false;
+	}
+
+	auto last = std::min(step + interval, state.timeSteps);
+
+	while (step < last) {
+		values = &scheme.advance(state, ++step);
+	}
+
+	return check();
+}
+
+template <typename T>
+bool TimeStepper<T>::check()
+{
+	if (divergenceFactor > 0) {
+		for (auto value : *values) {
+			// The comparison is false for NaN, so the not finite values are caught too
+			if (!(std::fabs(value) <= bound)) {
+				std::ostringstream text;
+
+				text << "Diverged! " << scheme.getName() << " exceeds " << bound << " at t = " << step * state.deltaT << " (step " << step << ")";
+				cancel(text.str());
+
+				return false;
+			}
+		}
+	}
+
+	if (condition && condition(current())) {
+		cancel(conditionReason);
+
+		return false;
+	}
+
+	return true;
+}
+
+template <typename T>
+typename TimeStepper<T>::View TimeStepper<T>::current() const
+{
+	return View{ std::max(step, 0), std::max(step, 0) * state.deltaT, *values, state };
+}
+
+template <typename T>
+void TimeStepper<T>::cancel(const std::string& _reason)
+{
+	status = Status::Cancelled;
+	reason = _reason;
+}
+
+template <typename T>
+void TimeStepper<T>::setDivergenceLimit(double factor)
+{
+	divergenceFactor = factor;
+}
+
+template <typename T>
+void TimeStepper<T>::stopWhen(std::function<bool(const View&)> _condition, const std::string& _reason)
+{
+	condition = _condition;
+	conditionReason = _reason;
+}
+
+template <typename T>
+typename TimeStepper<T>::Status TimeStepper<T>::getStatus() const
+{
+	return status;
+}
+
+template <typename T>
+std::string TimeStepper<T>::getReason() const
+{
+	return reason;
+}
+
+template <typename T>
+typename TimeStepper<T>::iterator TimeStepper<T>::begin()
+{
+	return iterator(next() ? this : nullptr);
+}
+
+template <typename T>
+typename TimeStepper<T>::iterator TimeStepper<T>::end()
+{
+	return iterator(nullptr);
+}
+
+// Explicit instantiation for the supported value types
+template class TimeStepper<float>;
+template class TimeStepper<double>;
@@ -0,0 +1,140 @@
+#pragma once // Include guard
+
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
+#include "AbstractScheme.h"
+
+/**
+* Lazy, pull based time stepping of a run (a generator of the time levels)
+* \nThe run is advanced only when the consumer asks for the next time level, so a run can be paused,
+* \nseveral runs can be interleaved on one thread by calling their next functions in turn,
+* \nand a run can be cancelled at any checkpoint. The views reference the values of the state, nothing is copied.
+* \nThe divergence guard and the stop condition cancel the run at the checkpoints, e.g. on NaN, blow-up or convergence.
+*
+* The TimeStepper class provides:
+* \n-next function to advance the run to the next checkpoint (the first call initialises the run)
+* \n-current function to get the view of the last checkpoint
+* \n-begin and end functions to iterate over the checkpoints with a range-based for loop
+* \n-setDivergenceLimit, stopWhen and cancel functions for the early termination
+*
+* The values of the state are stored with the T value type (float or double, default value is double)
+*/
+template <typename T = double>
+class TimeStepper
+{
+public:
+	/**
+	* The view of a checkpoint, the values are the ones of the state (valid until the next step)
+	*/
+	struct View
+	{
+		int step;
+		double time;
+		const std::vector<T>& values;
+		const SimulationState<T>& state;
+	};
+
+	/**
+	* The status of the run, a finished run reached the time frame of the state
+	*/
+	enum class Status { Running, Finished, Cancelled };
+
+	/**
+	* Input iterator over the checkpoints, incrementing it advances the run
+	*/
+	class iterator
+	{
+		TimeStepper* stepper;
+
+	public:
+		typedef std::input_iterator_tag iterator_category;
+		typedef View value_type;
+		typedef std::ptrdiff_t difference_type;
+		typedef const View* pointer;
+		typedef View reference;
+
+		explicit iterator(TimeStepper* _stepper) : stepper(_stepper) {}
+
+		View operator*() const { return stepper->current(); }
+		iterator& operator++() { if (!stepper->next()) stepper = nullptr; return *this; }
+		bool operator==(const iterator& that) const { return stepper == that.stepper; }
+		bool operator!=(const iterator& that) const { return stepper != that.stepper; }
+	};
+
+	/**
+	* Constructor of a run, nothing is calculated before the first next call
+	* @param scheme const AbstractScheme<T>& - The scheme of the run
+	* @param state SimulationState<T>& - The state of the run
+	* @param initialFunction std::shared_ptr<const BatchFunction> - The function of the initial values (evaluated at t = 0)
+	* @param interval int - The number of the time steps between two checkpoints, the last step is always a checkpoint (default value is 1)
+	*/
+	TimeStepper(const AbstractScheme<T>& scheme, SimulationState<T>& state, std::shared_ptr<const BatchFunction> initialFunction, int interval = 1);
+
+	/**
+	* Public method that advances the run to the next checkpoint
+	* The first call initialises the state and stops at the initial values (step 0).
+	* Throws UnstableSchemeException from the first call if the scheme would diverge with the Courant number of the state
+	* @return bool - True if a new checkpoint is available, false if the run is finished or cancelled
+	*/
+	bool next();
+
+	/**
+	* Public method that returns the view of the last checkpoint (also after the run is finished or cancelled)
+	* @return View - The step, the time frame and the values
+	*/
+	View current() const;
+
+	/**
+	* Public method that cancels the run, the following next calls return false
+	* @param reason std::string - The reason of the cancellation
+	*/
+	void cancel(const std::string& reason);
+
+	/**
+	* Public method that enables the divergence guard, the run is cancelled at the checkpoint where a value is not finite
+	* or its magnitude exceeds the factor times the largest initial magnitude (at least one)
+	* @param factor double - The allowed growth of the values
+	*/
+	void setDivergenceLimit(double factor);
+
+	/**
+	* Public method that sets a stop condition checked at every checkpoint, e.g. a convergence or error criterion
+	* @param condition std::function<bool(const View&)> - The condition, the run is cancelled when it returns true
+	* @param reason std::string - The reason of the cancellation
+	*/
+	void stopWhen(std::function<bool(const View&)> condition, const std::string& reason);
+
+	/**
+	* Public methods that return the status and the reason of the cancellation
+	*/
+	Status getStatus() const;
+	std::string getReason() const;
+
+	/**
+	* Public methods for the range-based for loop, begin advances the run to its first checkpoint
+	* @return iterator - The iterator of the checkpoints
+	*/
+	iterator begin();
+	iterator end();
+
+private:
+	const AbstractScheme<T>& scheme;
+	SimulationState<T>& state;
+	std::shared_ptr<const BatchFunction> initialFunction;
+	int interval, step;
+	const std::vector<T>* values;
+	Status status;
+	std::string reason;
+	double divergenceFactor, bound;
+	std::function<bool(const View&)> condition;
+	std::string conditionReason;
+
+	/**
+	* Private method that checks the divergence guard and the stop condition at a checkpoint
+	* @return bool - True if the run can continue
+	*/
+	bool check();
+};
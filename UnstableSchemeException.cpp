@@ -0,0 +1,18 @@
+#include <sstream>
+#include "UnstableSchemeException.h"
+
+static std::string message(const std::string& name, double cfl, double amplification, double stableCfl)
+{
+	std::ostringstream text;
+
+	text << "Unstable scheme! " << name << " amplifies the Fourier modes by " << amplification << " per time step with CFL " << cfl
+		<< ", the largest stable CFL is " << stableCfl << ".";
+
+	return text.str();
+}
+
+UnstableSchemeException::UnstableSchemeException(const std::string& name, double cfl, double amplification, double stableCfl)
+	: std::runtime_error(message(name, cfl, amplification, stableCfl))
+{
+
+}
@@ -0,0 +1,21 @@
+#pragma once // Include guard
+
+#include <stdexcept>
+#include <string>
+
+/**
+* Custom runtime exception class to handle the runs that would diverge
+* It overrides the default implementation of the what function to produce the error message
+*/
+class UnstableSchemeException : public std::runtime_error
+{
+public:
+	/**
+	* Constructor for the exception that will call the base class's constuctor to produce the error message
+	* @param name std::string - The name of the scheme
+	* @param cfl double - The requested Courant number
+	* @param amplification double - The largest amplification factor of the Fourier modes with the requested Courant number
+	* @param stableCfl double - The largest stable Courant number
+	*/
+	UnstableSchemeException(const std::string& name, double cfl, double amplification, double stableCfl);
+};
@@ -6,6 +6,7 @@
 /**
 * Static class for calculating different kind of vector norms
 * Only arithmetic types are allowed
+* \nThe infinite, 1st and 2nd norms of the float and double vectors are calculated by the dispatched kernels (Kernels.h)
 *
 * The VectorNorms class provides:
 * \n-inifiniteNorm function to retrieve the maximum element from the vector
@@ -26,19 +27,21 @@ public:
 	/**
 	* Static public method that returns a value of type T
 	* It returns the element with the highest value from the vector
-	* @param values vector<T> - Contains the actual values
+	* @param values vector<T, Allocator> - Contains the actual values, the storage can be taken from any allocator (e.g. an arena)
 	* @return T - The retrieved value
 	*/
-	static T infiniteNorm(std::vector<T>* values);
+	template <typename Allocator>
+	static T infiniteNorm(std::vector<T, Allocator>* values);
 
 	/**
 	* Static public method that returns a double
 	* It returns the n-th norm of the vector
-	* @param values vector<T> - Contains the actual values
+	* @param values vector<T, Allocator> - Contains the actual values, the storage can be taken from any allocator (e.g. an arena)
 	* @param p int - The number of the norm to be calculated
 	* @return double - The calculated value of the n-th norm
 	*/
-	static double pNorm(std::vector<T>* values, int p);
+	template <typename Allocator>
+	static double pNorm(std::vector<T, Allocator>* values, int p);
 };
 
 // Include the cpp file (which is actually renamned to .tpp) so the Linker will be able to generate the class for different types
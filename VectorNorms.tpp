@@ -2,23 +2,63 @@
 
 #include <cmath>
 #include <algorithm>
+#include "Kernels.h"
 
-template <class T>
-T VectorNorms<T>::infiniteNorm(std::vector<T>* vec){
+// The generic reductions of the elements, the floating point vectors use the dispatched kernels for the common norms
+template <class T, class A>
+T maximumElement(const std::vector<T, A>& vec){
 
-    return *std::max_element((*vec).begin(), (*vec).end());
+    return *std::max_element(vec.begin(), vec.end());
 }
 
-template <class T>
-double VectorNorms<T>::pNorm(std::vector<T>* vec, int p){
+template <class T, class A>
+double sumOfPowers(const std::vector<T, A>& vec, int p){
 
 	auto sum = 0.0;
 
-	for (auto& elem: (*vec)) {
+	for (auto& elem: vec) {
         sum += pow(elem, p);
 	}
 
-    return pow(sum, 1.0/p);
+    return sum;
+}
+
+template <class A>
+inline float maximumElement(const std::vector<float, A>& vec){
+
+    return Kernels::get<float>().maximum(vec.data(), vec.size());
+}
+
+template <class A>
+inline double maximumElement(const std::vector<double, A>& vec){
+
+    return Kernels::get<double>().maximum(vec.data(), vec.size());
+}
+
+template <class A>
+inline double sumOfPowers(const std::vector<float, A>& vec, int p){
+
+    return p == 1 || p == 2 ? Kernels::get<float>().sumOfPowers(vec.data(), vec.size(), p) : sumOfPowers<float, A>(vec, p);
+}
+
+template <class A>
+inline double sumOfPowers(const std::vector<double, A>& vec, int p){
+
+    return p == 1 || p == 2 ? Kernels::get<double>().sumOfPowers(vec.data(), vec.size(), p) : sumOfPowers<double, A>(vec, p);
+}
+
+template <class T>
+template <class Allocator>
+T VectorNorms<T>::infiniteNorm(std::vector<T, Allocator>* vec){
+
+    return maximumElement(*vec);
+}
+
+template <class T>
+template <class Allocator>
+double VectorNorms<T>::pNorm(std::vector<T, Allocator>* vec, int p){
+
+    return pow(sumOfPowers(*vec, p), 1.0/p);
 }
 
 #endif
\ No newline at end of file
@@ -0,0 +1,270 @@
+#include <algorithm>
+#include <cmath>
+#include "WENOScheme.h"
+#include "Kernels.h"
+
+// The linear weights of the candidate stencils and the regularisation of the smoothness indicators (Jiang and Shu)
+static const double optimalWeights[] = { 0.1, 0.6, 0.3 };
+static const double smoothnessEpsilon = 1e-6;
+
+// The interface value of the optimal weights, the coefficients of the cells i-2 ... i+2 for the interface i + 1/2
+static const double linearFace[] = { 2.0 / 60, -13.0 / 60, 47.0 / 60, 27.0 / 60, -3.0 / 60 };
+
+template <typename T>
+WENOScheme<T>::WENOScheme(double xStart, double xEnd, double t, int spacePoints, double u, double cfl)
+	: FluxFormScheme<T>("WENO5 Scheme", xStart, xEnd, t, spacePoints, u, cfl)
+{
+
+}
+
+template <typename T>
+int WENOScheme<T>::stencilRadius() const
+{
+	return 9;
+}
+
+template <typename T>
+int WENOScheme<T>::boundaryCells() const
+{
+	return 1;
+}
+
+template <typename T>
+std::unique_ptr<SimulationState<T>> WENOScheme<T>::allocateState() const
+{
+	return std::unique_ptr<SimulationState<T>>(new State());
+}
+
+template <typename T>
+void WENOScheme<T>::prepare(SimulationState<T>& _state, std::shared_ptr<const BatchFunction> initialFunction) const
+{
+	auto& state = static_cast<State&>(_state);
+
+	// Only the active region and its halo of the stage are read, they are written in every time step
+	state.stage.resize(state.spacePoints + 1);
+	state.fluxes.resize(state.spacePoints);
+}
+
+// The weighted interface value, inlined into the loop of the fluxes so it is vectorised
+template <typename T>
+static inline T weightedValue(T a, T b, T c, T d, T e)
+{
+	const T sixth = T(1) / 6, thirteenTwelfths = T(13) / 12, quarter = 0.25, epsilon = static_cast<T>(smoothnessEpsilon);
+
+	// The third order candidate values of the interface
+	auto p0 = sixth * (2 * a - 7 * b + 11 * c);
+	auto p1 = sixth * (-b + 5 * c + 2 * d);
+	auto p2 = sixth * (2 * c + 5 * d - e);
+
+	// The smoothness indicators, the candidates crossing a jump get a negligible weight
+	auto s0 = a - 2 * b + c, t0 = a - 4 * b + 3 * c;
+	auto s1 = b - 2 * c + d, t1 = b - d;
+	auto s2 = c - 2 * d + e, t2 = 3 * c - 4 * d + e;
+	auto beta0 = epsilon + thirteenTwelfths * s0 * s0 + quarter * t0 * t0;
+	auto beta1 = epsilon + thirteenTwelfths * s1 * s1 + quarter * t1 * t1;
+	auto beta2 = epsilon + thirteenTwelfths * s2 * s2 + quarter * t2 * t2;
+
+	// The weights are optimalWeights[k] / beta_k^2, normalised over the common denominator, so there is a single division
+	auto square0 = beta0 * beta0, square1 = beta1 * beta1, square2 = beta2 * beta2;
+	auto alpha0 = static_cast<T>(optimalWeights[0]) * (square1 * square2);
+	auto alpha1 = static_cast<T>(optimalWeights[1]) * (square0 * square2);
+	auto alpha2 = static_cast<T>(optimalWeights[2]) * (square0 * square1);
+
+	return (alpha0 * p0 + alpha1 * p1 + alpha2 * p2) / (alpha0 + alpha1 + alpha2);
+}
+
+// The loops run in blocks of a fixed number of cells (like the dispatched kernels), the compiler vectorises
+// the blocks at -O2 without a scalar epilogue, the remaining cells are calculated one by one
+template <typename T>
+struct BlockCells
+{
+	static const std::size_t count = 128 / sizeof(T);
+};
+
+// The fluxes of count interfaces for a fixed direction, the cells of the stencils are at constant offsets with unit stride
+template <int Direction, typename T>
+static void weightedFluxLoop(const T* __restrict upwind, T* __restrict fluxes, std::size_t count, T u)
+{
+	const auto block = BlockCells<T>::count;
+	auto a = upwind - 2 * Direction, b = upwind - Direction, c = upwind, d = upwind + Direction, e = upwind + 2 * Direction;
+	std::size_t j = 0;
+
+	for (; j + block <= count; j += block) {
+		for (std::size_t l = 0; l < block; l++) {
+			fluxes[j + l] = u * weightedValue(a[j + l], b[j + l], c[j + l], d[j + l], e[j + l]);
+		}
+	}
+
+	for (; j < count; j++) {
+		fluxes[j] = u * weightedValue(a[j], b[j], c[j], d[j], e[j]);
+	}
+}
+
+// One Runge-Kutta stage, next[i] = a * q[i] + b * (stage[i] - ratio * (fluxes[i] - fluxes[i - 1])), fluxes[-1] is read
+template <typename T>
+static void rungeKuttaStage(const T* __restrict q, const T* __restrict stage, const T* __restrict fluxes, T* __restrict next, T a, T b, T ratio, std::size_t count)
+{
+	const auto block = BlockCells<T>::count;
+	std::size_t i = 0;
+
+	for (; i + block <= count; i += block) {
+		for (std::size_t l = 0; l < block; l++) {
+			next[i + l] = a * q[i + l] + b * (stage[i + l] - ratio * (fluxes[i + l] - fluxes[i + l - 1]));
+		}
+	}
+
+	for (; i < count; i++) {
+		next[i] = a * q[i] + b * (stage[i] - ratio * (fluxes[i] - fluxes[i - 1]));
+	}
+}
+
+template <typename T>
+T WENOScheme<T>::reconstruct(T a, T b, T c, T d, T e)
+{
+	return weightedValue(a, b, c, d, e);
+}
+
+template <typename T>
+void WENOScheme<T>::weightedFluxes(const T* upwind, T* fluxes, std::size_t count, int direction, T u)
+{
+	// The direction is a template parameter of the loops, so the offsets of the stencil are constants
+	if (direction > 0) {
+		weightedFluxLoop<1>(upwind, fluxes, count, u);
+	}
+	else {
+		weightedFluxLoop<-1>(upwind, fluxes, count, u);
+	}
+}
+
+template <typename T>
+void WENOScheme<T>::stageFluxes(const std::vector<T>& q, std::vector<T>& fluxes, int first, int last) const
+{
+	auto spacePoints = (int)q.size() - 1;
+	auto u = static_cast<T>(this->u);
+	auto direction = this->u >= 0 ? 1 : -1;
+
+	// The upwind cell of the interface i is i, or i + 1 for the negative velocities
+	auto shift = direction > 0 ? 0 : 1;
+	auto cell = [&](int i) { return q[std::min(std::max(i, 0), spacePoints)]; };
+	auto clamped = [&](int i) {
+		auto upwind = i + shift;
+
+		fluxes[i] = u * reconstruct(cell(upwind - 2 * direction), cell(upwind - direction), cell(upwind), cell(upwind + direction), cell(upwind + 2 * direction));
+	};
+
+	// The interfaces whose stencils are inside the grid
+	auto low = std::max(first, 2), high = std::min(last, spacePoints - 3);
+
+	for (auto i = first; i <= std::min(last, low - 1); i++) {
+		clamped(i);
+	}
+
+	if (low <= high) {
+		weightedFluxes(q.data() + low + shift, fluxes.data() + low, high - low + 1, direction, u);
+	}
+
+	for (auto i = std::max(high + 1, low); i <= last; i++) {
+		clamped(i);
+	}
+}
+
+// Define the pure virtual function of the base class
+template <typename T>
+void WENOScheme<T>::calculateFluxes(typename FluxFormScheme<T>::State& state, int first, int last) const
+{
+	stageFluxes(state.currentValues, state.fluxes, first, last);
+}
+
+template <typename T>
+const std::vector<T>& WENOScheme<T>::calculateIteration(SimulationState<T>& _state, double t) const
+{
+	auto& state = static_cast<State&>(_state);
+	auto& q = state.currentValues;
+	auto& stage = state.stage;
+	auto& next = state.nextValues;
+	auto& fluxes = state.fluxes;
+	auto spacePoints = state.spacePoints;
+	auto ratio = static_cast<T>(state.deltaT / state.deltaX);
+	auto first = std::max(state.activeFirst, 1), last = std::min(state.activeLast, spacePoints - 1);
+	const T threeQuarters = 0.75, quarter = 0.25, third = T(1) / 3, twoThirds = T(2) / 3;
+
+	stage[0] = next[0] = static_cast<T>(this->left);
+	stage[spacePoints] = next[spacePoints] = static_cast<T>(this->right);
+
+	if (first <= last) {
+		auto count = (std::size_t)(last - first + 1);
+
+		// The stencils reach three cells beyond the active region, there the stage keeps the constant current values
+		auto haloFirst = std::max(first - 3, 1), haloLast = std::min(last + 3, spacePoints - 1);
+
+		std::copy(q.begin() + haloFirst, q.begin() + first, stage.begin() + haloFirst);
+		std::copy(q.begin() + last + 1, q.begin() + haloLast + 1, stage.begin() + last + 1);
+
+		// First stage, forward Euler step into the next values (they are valid outside of the active region)
+		stageFluxes(q, fluxes, first - 1, last);
+		Kernels::get<T>().conservativeUpdate(q.data() + first, fluxes.data() + first, next.data() + first, ratio, count);
+
+		// Second stage, a quarter of the Euler step of the first stage
+		stageFluxes(next, fluxes, first - 1, last);
+		rungeKuttaStage(q.data() + first, next.data() + first, fluxes.data() + first, stage.data() + first, threeQuarters, quarter, ratio, count);
+
+		// Third stage, two thirds of the Euler step of the second stage
+		stageFluxes(stage, fluxes, first - 1, last);
+		rungeKuttaStage(q.data() + first, stage.data() + first, fluxes.data() + first, next.data() + first, third, twoThirds, ratio, count);
+	}
+
+	q.swap(next);
+
+	return q;
+}
+
+template <typename T>
+std::vector<Stencil> WENOScheme<T>::getStencils(double cfl) const
+{
+	auto nu = std::fabs(cfl);
+
+	// The operator of a forward Euler step on the cells i-3 ... i+2, the difference of the two linear interface values
+	std::vector<double> euler(6, 0.0);
+
+	for (auto k = 0; k < 5; k++) {
+		euler[k + 1] -= nu * linearFace[k];
+		euler[k] += nu * linearFace[k];
+	}
+
+	// The time step is 1 + A + A^2 / 2 + A^3 / 6, the powers of A are the repeated convolutions of its stencil
+	std::vector<double> power(1, 1.0), step(16, 0.0);
+	auto factor = 1.0;
+
+	step[9] = 1;
+
+	for (auto order = 1; order <= 3; order++) {
+		std::vector<double> product(power.size() + euler.size() - 1, 0.0);
+
+		for (std::size_t i = 0; i < power.size(); i++) {
+			for (std::size_t k = 0; k < euler.size(); k++) {
+				product[i + k] += power[i] * euler[k];
+			}
+		}
+
+		power.swap(product);
+		factor /= order;
+
+		// The power A^order covers the cells i - 3 * order ... i + 2 * order
+		for (std::size_t i = 0; i < power.size(); i++) {
+			step[9 - 3 * order + i] += factor * power[i];
+		}
+	}
+
+	// The negative velocities mirror the stencil
+	if (cfl < 0) {
+		std::reverse(step.begin(), step.end());
+
+		return { Stencil{ -6, step, {} } };
+	}
+
+	return { Stencil{ -9, step, {} } };
+}
+
+// Explicit instantiation for the supported value types
+template class WENOScheme<float>;
+template class WENOScheme<double>;
@@ -0,0 +1,119 @@
+#pragma once // Include guard
+
+#include <cstddef>
+#include "FluxFormScheme.h"
+
+/**
+* Fifth order WENO scheme class derived from the Flux-form scheme
+* \nThe interface values are reconstructed from the three third order candidate stencils, weighted by their
+* \nsmoothness (Jiang and Shu), so the scheme is fifth order in the smooth regions and does not ring at the jumps.
+* \nThe time integration is the third order strong-stability-preserving Runge-Kutta method (Shu and Osher),
+* \nevery time step is three flux-form updates into the preallocated stage buffers of the state.
+*
+* The WENOScheme class provides:
+* \n-reconstruct function to calculate a single reconstructed interface value
+* \n-weightedFluxes function, the reconstruction of a run of interfaces (vectorised across the cells)
+*/
+template <typename T = double>
+class WENOScheme : public FluxFormScheme<T>
+{
+protected:
+	/**
+	* The state of a run of the WENO scheme
+	*/
+	class State : public FluxFormScheme<T>::State
+	{
+	public:
+		/**
+		* The values of the second Runge-Kutta stage, the first and third stages are built in the next values
+		* \nOnly the active region and the three cells beyond it are written, the stencils read no other cells
+		*/
+		std::vector<T> stage;
+	};
+
+	/**
+	* Override the state allocation to provide the stage buffer
+	* @return std::unique_ptr<SimulationState<T>> - The new state
+	*/
+	std::unique_ptr<SimulationState<T>> allocateState() const override;
+
+	/**
+	* Override the preparation to allocate the stage and flux buffers before the first time step
+	*/
+	void prepare(SimulationState<T>& state, std::shared_ptr<const BatchFunction> initialFunction) const override;
+
+	/**
+	* Override the pure virtual function to calculate the reconstructed fluxes of the current values
+	* The missing neighbours at the boundaries are replaced with the boundary cells
+	*/
+	void calculateFluxes(typename FluxFormScheme<T>::State& state, int first, int last) const override;
+
+	/**
+	* The reconstruction uses the i-3 ... i+3 cells and a time step has three stages
+	* @return int - The radius of the stencil of a whole time step
+	*/
+	int stencilRadius() const override;
+
+	/**
+	* Only the first and last cells are kept at the boundary values
+	* @return int - The number of boundary cells
+	*/
+	int boundaryCells() const override;
+
+private:
+	/**
+	* Private method that calculates the fluxes of the given values at the first ... last interfaces
+	* @param q const std::vector<T>& - The values of the stage
+	* @param fluxes std::vector<T>& - The fluxes, fluxes[i] is the flux between the cell i and i + 1
+	* @param first int - The index of the first flux
+	* @param last int - The index of the last flux
+	*/
+	void stageFluxes(const std::vector<T>& q, std::vector<T>& fluxes, int first, int last) const;
+
+public:
+	/**
+	* Constructor for the WENO scheme
+	* @param xStart double - Beginning of the space dimension
+	* @param xEnd double - End of the space dimension
+	* @param t double - The timeframe until the calculations should be executed
+	* @param spacePoints int - The number of intervals in the space dimension
+	* @param u double - The velocity of the wave
+	* @param cfl double - The Courant number
+	*/
+	WENOScheme(double xStart, double xEnd, double t, int spacePoints, double u, double cfl);
+
+	/**
+	* Override the pure virtual function to advance the values with the three Runge-Kutta stages
+	* @param state SimulationState<T>& - The state of the run
+	* @param double t - The current time frame
+	* @return const std::vector<T>& - The calculated numerical values
+	*/
+	const std::vector<T>& calculateIteration(SimulationState<T>& state, double t) const override;
+
+	/**
+	* Static public method that returns the reconstructed value at the downwind interface of the c cell
+	* The cells are ordered in the direction of the wave, a is the farthest upwind
+	* @param a T, b T, c T, d T, e T - The values of the five consecutive cells
+	* @return T - The weighted combination of the three candidate values
+	*/
+	static T reconstruct(T a, T b, T c, T d, T e);
+
+	/**
+	* Static public method that calculates the fluxes of count consecutive interfaces
+	* The direction selects a loop with constant stencil offsets, it runs in blocks of a fixed number of interfaces,
+	* \nso the compiler vectorises it across the interfaces without a scalar epilogue
+	* @param upwind const T* - The upwind cell of the first interface, the cells of the stencil are within two cells
+	* @param fluxes T* - The calculated fluxes
+	* @param count std::size_t - The number of the interfaces
+	* @param direction int - The direction of the wave (1 or -1)
+	* @param u T - The velocity of the wave
+	*/
+	static void weightedFluxes(const T* upwind, T* fluxes, std::size_t count, int direction, T u);
+
+	/**
+	* Override the stencils with the linear scheme of the optimal weights
+	* The smooth solutions are advanced with the fifth order upwind stencil, the stencil of the time step
+	* is the third order Taylor polynomial of it (the Runge-Kutta method is exact for linear operators up to third order)
+	*/
+	std::vector<Stencil> getStencils(double cfl) const override;
+};
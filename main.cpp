@@ -7,16 +7,43 @@
 #include "ImplicitUpwindScheme.h"
 #include "LaxWendroffScheme.h"
 #include "RichtmyerScheme.h"
+#include "TVDScheme.h"
+#include "WENOScheme.h"
+#include "SpectralScheme.h"
+#include "AdaptiveMeshScheme.h"
+#include "PararealSolver.h"
+#include "PrecisionBenchmark.h"
+#include "AdaptiveMeshBenchmark.h"
+#include "EnsembleEvaluator.h"
 #include "ConsoleReader.h"
 #include "UninitializedFunctionException.h"
+#include "UnstableSchemeException.h"
 #include "VectorNorms.h"
+#include "GaussianProfile.h"
+#include "StepProfile.h"
+#include "BatchRunner.h"
+#include "ResultCache.h"
 
 // Function prototype
 auto sgn(double) -> int;
-auto evaluateScheme(std::shared_ptr<AbstractScheme>) -> void;
+auto evaluateScheme(std::shared_ptr<AbstractScheme<>>, ResultCache&, std::ostream&) -> void;
+auto calculateVariations(std::shared_ptr<AbstractScheme<>>, ResultCache&) -> void;
 
-auto main() -> int
+auto main(int argc, char* argv[]) -> int
 {
+	// Batch mode, the jobs are read from the file without any prompt
+	if (argc == 3 && std::string(argv[1]) == "--batch") {
+		return BatchRunner(std::cerr).run(argv[2]);
+	}
+
+	// The timing benchmark is opt-in, so the results of the interactive runs are reproducible
+	auto benchmark = argc == 2 && std::string(argv[1]) == "--benchmark";
+
+	if (argc > 1 && !benchmark) {
+		std::cerr << "Usage: " << argv[0] << " [--batch <job file> | --benchmark]" << std::endl;
+		return BatchRunner::InvalidJobFile;
+	}
+
 	// Pre-defined values for the calculations
 	auto x_start = -50.0, x_end = 50.0, u = 1.75;
 
@@ -29,38 +56,123 @@ auto main() -> int
 	std::ofstream file;
 	file.open("userresults.txt", std::ios_base::app);
 
-	// Calculate the values for the first problem using different schemes
-	std::shared_ptr<AbstractScheme> scheme(new ExplicitUpwindScheme(x_start, x_end, t, space_points, u, cfl, file));
-	evaluateScheme(scheme);
+	// The schemes on the user's grid, including the flux limited second order and the WENO schemes
+	std::vector<std::shared_ptr<AbstractScheme<>>> schemes = {
+		std::make_shared<ExplicitUpwindScheme<>>(x_start, x_end, t, space_points, u, cfl),
+		std::make_shared<ImplicitUpwindScheme<>>(x_start, x_end, t, space_points, u, cfl),
+		std::make_shared<LaxWendroffScheme<>>(x_start, x_end, t, space_points, u, cfl),
+		std::make_shared<RichtmyerScheme<>>(x_start, x_end, t, space_points, u, cfl)
+	};
 
-	scheme = std::make_shared<ImplicitUpwindScheme>(x_start, x_end, t, space_points, u, cfl, file);
-	evaluateScheme(scheme);
+	for (auto limiter : { FluxLimiter::Minmod, FluxLimiter::VanLeer, FluxLimiter::Superbee }) {
+		schemes.push_back(std::make_shared<TVDScheme<>>(x_start, x_end, t, space_points, u, cfl, limiter));
+	}
 
-	scheme = std::make_shared<LaxWendroffScheme>(x_start, x_end, t, space_points, u, cfl, file);
-	evaluateScheme(scheme);
+	// The fifth order scheme reaches the accuracy of the second order ones with far fewer points
+	schemes.push_back(std::make_shared<WENOScheme<>>(x_start, x_end, t, space_points, u, cfl));
 
-	scheme = std::make_shared<RichtmyerScheme>(x_start, x_end, t, space_points, u, cfl, file);
-	evaluateScheme(scheme);
+	// The quiescent cells are skipped, the results are the same
+	for (auto& scheme : schemes) {
+		scheme->setActiveRegionTracking(true);
+	}
+
+	// Calculate what the user asked for, all schemes are advanced in lock-step and share the analytical values
+	EnsembleEvaluator ensemble(schemes, file);
+
+	ensemble.evaluate(std::make_shared<StepProfile>(u), 0, 1);
+	ensemble.evaluate(std::make_shared<GaussianProfile>(0.5, u), 0, 0);
+
+	// Calculate all the possibilities and write the results into files, the unchanged ones are copied from the cache
+	ResultCache cache("cache", 256ULL << 20, ResultCache::buildVersion());
+
+	for (auto& scheme : schemes) {
+		calculateVariations(scheme, cache);
+	}
+
+	std::shared_ptr<AbstractScheme<>> scheme = std::make_shared<AdaptiveMeshScheme>(x_start, x_end, t, space_points, u, cfl);
+	evaluateScheme(scheme, cache, file);
+
+	// Periodic Fourier solution of the smooth pulse, the time frame is reached with one exact phase shift
+	auto spectral = std::make_shared<SpectralScheme<>>(x_start, x_end, t, space_points, u, cfl);
+	auto pulse = std::make_shared<GaussianProfile>(0.5, u);
+
+	spectral->setFunction(pulse, 0, 0);
+	spectral->evaluate(pulse, file);
+
+	// Parallel-in-time solution, Explicit Upwind on the coarse grid corrects Lax-Wendroff on the user's grid
+	auto coarse_points = space_points % 2 == 0 ? space_points / 2 : space_points;
+	auto step = std::make_shared<StepProfile>(u);
+
+	auto coarse = std::make_shared<ExplicitUpwindScheme<>>(x_start, x_end, t, coarse_points, u, cfl);
+	auto fine = std::make_shared<LaxWendroffScheme<>>(x_start, x_end, t, space_points, u, cfl);
+	coarse->setFunction(step, 0, 1);
+	fine->setFunction(step, 0, 1);
+
+	PararealSolver parareal(coarse, fine, 8, 8, 1e-6);
+
+	try {
+		// The timings are only written to the results with the benchmark, so the file is reproducible
+		parareal.solve([](double x) {return 0.5 * (sgn(x) + 1); }, t, file, benchmark ? &file : &std::cout);
+	}
+	catch (const UnstableSchemeException& use)
+	{
+		file << use.what() << std::endl;
+		std::cerr << use.what() << std::endl;
+	}
+
+	// Single, mixed and double precision throughput and accuracy, adaptive mesh against the uniform finest grid
+	if (benchmark) {
+		PrecisionBenchmark::run(file, space_points, t);
+		AdaptiveMeshBenchmark::run(file, space_points, t);
+	}
 
 	file.close();
 
+	cache.writeStats(std::cout);
+
 	system("pause");
 }
 
-auto evaluateScheme(std::shared_ptr<AbstractScheme> scheme) -> void
+auto evaluateScheme(std::shared_ptr<AbstractScheme<>> scheme, ResultCache& cache, std::ostream& file) -> void
 {
 	try {
+		// The quiescent cells are skipped, the results are the same
+		scheme->setActiveRegionTracking(true);
+
+		// The profiles are evaluated for the whole grid at once, the initial values are the profiles at t = 0
+		auto step = std::make_shared<StepProfile>(1.75);
+		auto gaussian = std::make_shared<GaussianProfile>(0.5, 1.75);
+
 		// Calculate what the user asked for
-		scheme->setFunction([](double x, double t) {return 0.5 * (sgn(x - 1.75 * t) + 1); }, 0, 1);
-		scheme->evaluate([](double x) {return 0.5 * (sgn(x) + 1); });
+		scheme->setFunction(step, 0, 1);
+		scheme->evaluate(step, file);
+
+		scheme->setFunction(gaussian, 0, 0);
+		scheme->evaluate(gaussian, file);
+	}
+	catch (UninitializedFunctionException ufe)
+	{
+		std::cerr << ufe.what() << std::endl;
+	}
+	catch (const UnstableSchemeException& use)
+	{
+		std::cerr << use.what() << std::endl;
+	}
 
-		scheme->setFunction([](double x, double t) {return 0.5 * std::exp(-std::pow(x - 1.75 * t, 2)); }, 0, 0);
-		scheme->evaluate([](double x) {return 0.5 * std::exp(-std::pow(x, 2)); });
+	calculateVariations(scheme, cache);
+}
+
+auto calculateVariations(std::shared_ptr<AbstractScheme<>> scheme, ResultCache& cache) -> void
+{
+	try {
+		auto step = std::make_shared<StepProfile>(1.75);
+		auto gaussian = std::make_shared<GaussianProfile>(0.5, 1.75);
 
 		// Calculate all the possibilities and write the results into files
-		scheme->calculateAllVariations("exp", [](double x) {return 0.5 * std::exp(-std::pow(x, 2)); });
-		scheme->setFunction([](double x, double t) {return 0.5 * (sgn(x - 1.75 * t) + 1); }, 0, 1);
-		scheme->calculateAllVariations("sgn", [](double x) {return 0.5 * (sgn(x) + 1); });
+		scheme->setFunction(gaussian, 0, 0);
+		scheme->calculateAllVariations("exp", gaussian, &cache);
+		scheme->setFunction(step, 0, 1);
+		scheme->calculateAllVariations("sgn", step, &cache);
 	}
 	catch (UninitializedFunctionException ufe)
 	{
@@ -71,4 +183,4 @@ auto evaluateScheme(std::shared_ptr<AbstractScheme> scheme) -> void
 auto sgn(double value) -> int
 {
 	return (value > 0) - (value < 0);
-}
\ No newline at end of file
+}